@@ -20,6 +20,7 @@
 #pragma once
 #include "pack/defines.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #if PACK_LITTLE_ENDIAN
 /**
@@ -33,24 +34,49 @@
 #define PACK_HEADER_MAGIC (('P' << 24) | ('A' << 16) | ('C' << 8) | 'K')
 #endif
 
+/**
+ * @brief Pack item compression frame size in bytes.
+ * @details Compressed items bigger than this size are split into the independently compressed frames.
+ */
+#define PACK_FRAME_SIZE 262144
+
+/**
+ * @brief Pack solid block max data size in bytes.
+ * @details Small items are grouped into the shared compressed blocks of up to this size.
+ */
+#define PACK_BLOCK_SIZE 65536
+
 /**
  * @brief Pack file header structure.
  *
  * @details
  * Each Pack file begins with a header that contains information about the library and system 
  * used for packing the files. It also contains the total number of files inside the archive.
+ * 
+ * The header is followed by the item index block, which contains all @ref PackItemHeader structures, 
+ * then the item path hash table (see the @ref PackHashSlot) and then all item path strings in the same 
+ * order. Item binary data is stored after the index block, so the whole index can be loaded with a 
+ * single sequential read.
+ * 
+ * If the archive was packed with a trained dictionary, it's stored between the index block and the item data. 
+ * All compressed items are then compressed using this dictionary. (ZSTD or raw LZ4 dictionary)
+ * 
+ * If hasChecksums is set, the hash table is followed by the uint32_t checksum array, one for each item. 
+ * It contains @ref computePackChecksum() value of the uncompressed item data, used to detect corrupted data.
  */
 typedef struct PackHeader
 {
-	uint32_t magic;          /**< Pack file magic number */
-	uint8_t versionMajor;    /**< File format major version */
-	uint8_t versionMinor;    /**< File format minor version */
-	uint8_t versionPatch;    /**< File format patch version */
-	uint8_t isBigEndian;     /**< Is packed data format big endian */
-	uint64_t itemCount;      /**< Total pack item count */
-	uint32_t dataVersion;    /**< Packed file data version */
-	uint8_t preferSpeed : 1; /**< Is data compressed with fast-read algorithm */
-	uint32_t _reserved : 31; /**< Reserved for future use */
+	uint32_t magic;               /**< Pack file magic number */
+	uint8_t versionMajor;         /**< File format major version */
+	uint8_t versionMinor;         /**< File format minor version */
+	uint8_t versionPatch;         /**< File format patch version */
+	uint8_t isBigEndian;          /**< Is packed data format big endian */
+	uint64_t itemCount;           /**< Total pack item count */
+	uint32_t dataVersion;         /**< Packed file data version */
+	uint8_t preferSpeed : 1;      /**< Is data compressed with fast-read algorithm by default */
+	uint32_t dictionarySize : 30; /**< Compression dictionary size in bytes, or 0 */
+	uint8_t hasChecksums : 1;     /**< Does index contain item data checksums */
+	uint64_t indexSize;           /**< Item index block size in bytes */
 } PackHeader;
 
 /**
@@ -59,16 +85,56 @@ typedef struct PackHeader
  * @details
  * Contains information about the packed file inside the archive. This includes the size of its path, 
  * the size of compressed data, whether data are compressed, and the location of the data within the archive file.
+ * 
+ * Compressed items bigger than the @ref PACK_FRAME_SIZE are seekable. Their data begins with a seek table 
+ * of @ref getPackFrameCount() uint32_t compressed frame sizes, followed by the independently compressed 
+ * frames, each of them contains PACK_FRAME_SIZE bytes of the item data (except the last one).
+ * 
+ * Each compressed item has its own compression algorithm, so one archive can contain both 
+ * fast-read (LZ4) and maximum compression (ZSTD) items. Items with zero zipSize are stored as is.
+ * 
+ * Small items can be stored inside the solid blocks, compressed together with the neighbour items. 
+ * Solid item dataOffset points to the @ref PackBlockHeader and zipSize is the item data offset 
+ * inside the uncompressed block data.
  */
 typedef struct PackItemHeader
 {
-	uint32_t zipSize;         /**< Compressed item size in bytes */
+	uint32_t zipSize;         /**< Compressed item size in bytes, or offset inside the solid block */
 	uint32_t dataSize;        /**< Uncompressed item size in bytes */
 	uint8_t pathSize : 8;     /**< Item path string length */
 	uint8_t isReference : 1;  /**< Is binary data shared between several items */
-	uint64_t dataOffset : 55; /**< Binary data offset in the Pack file */
+	uint8_t preferSpeed : 1;  /**< Is item compressed with fast-read algorithm */
+	uint64_t dataOffset : 53; /**< Binary data offset in the Pack file */
+	uint8_t isSolid : 1;      /**< Is item stored inside the solid block */
 } PackItemHeader;
 
+/**
+ * @brief Pack solid block header structure.
+ *
+ * @details
+ * Solid block header is followed by the block data compressed as one frame (with the algorithm of its items). 
+ * Uncompressed block data is the concatenated data of the items, it's at most @ref PACK_BLOCK_SIZE bytes.
+ */
+typedef struct PackBlockHeader
+{
+	uint32_t zipSize;  /**< Compressed block data size in bytes */
+	uint32_t dataSize; /**< Uncompressed block data size in bytes */
+} PackBlockHeader;
+
+/**
+ * @brief Pack item path hash table slot structure.
+ *
+ * @details
+ * Pack index contains an open addressing (linear probing) hash table of the item paths, it has 
+ * @ref getPackHashSlotCount() slots. Slot position is the lower bits of the @ref hashPackItemPath() 
+ * value and upper 32 bits of the value are stored in the slot to skip most of the path comparisons.
+ */
+typedef struct PackHashSlot
+{
+	uint32_t pathHash;  /**< Upper 32 bits of the item path hash */
+	uint32_t itemIndex; /**< Item index + 1, or 0 if slot is empty */
+} PackHashSlot;
+
 /***********************************************************************************************************************
  * @brief Pack result codes.
  * @enum
@@ -91,7 +157,9 @@ typedef enum PackResult_T
 	BAD_FILE_VERSION_PACK_RESULT = 13,
 	BAD_FILE_ENDIANNESS_PACK_RESULT = 14,
 	BAD_FILE_DATA_VERSION_PACK_RESULT = 15,
-	PACK_RESULT_COUNT = 16
+	BAD_ITEM_CHECKSUM_PACK_RESULT = 16,
+	DUPLICATE_ITEM_PATH_PACK_RESULT = 17,
+	PACK_RESULT_COUNT = 18
 } PackResult_T;
 /**
  * @brief Pack result code type.
@@ -128,6 +196,41 @@ void getPackLibraryVersion(uint8_t* major, uint8_t* minor, uint8_t* patch);
  */
 PackResult readPackHeader(const char* filePath, PackHeader* header);
 
+/**
+ * @brief Returns Pack item path hash value. (MT-Safe)
+ * @details Used to build and search Pack item path hash table.
+ *
+ * @param[in] path item path string
+ * @param pathSize item path string length
+ */
+uint64_t hashPackItemPath(const char* path, uint8_t pathSize);
+/**
+ * @brief Returns Pack item path hash table slot count. (MT-Safe)
+ * @details Hash table size is always a power of two and at least twice the item count (capped at 2^63).
+ * @param itemCount total pack item count
+ */
+uint64_t getPackHashSlotCount(uint64_t itemCount);
+/**
+ * @brief Returns Pack item compression frame count. (MT-Safe)
+ * @details Compressed item is seekable if it has more than one frame.
+ * @param dataSize uncompressed item size in bytes
+ */
+uint32_t getPackFrameCount(uint32_t dataSize);
+
+/**
+ * @brief Computes Pack item data checksum. (MT-Safe)
+ * 
+ * @details
+ * Checksum is the CRC32C (Castagnoli) of the data, computed with the SSE4.2 or ARMv8 CRC32 instructions 
+ * if they are supported by the CPU, which is fast enough to verify item data on each read.
+ * Data can be processed in parts by passing the previous checksum value.
+ *
+ * @param[in] data target data to compute checksum
+ * @param size data size in bytes
+ * @param checksum previous data part checksum, or 0
+ */
+uint32_t computePackChecksum(const uint8_t* data, size_t size, uint32_t checksum);
+
 /***********************************************************************************************************************
  * @brief Pack result code string array.
  */
@@ -147,7 +250,9 @@ static const char* const packResultStrings[PACK_RESULT_COUNT] = {
 	"Bad file type",
 	"Bad file version",
 	"Bad file endianness",
-	"Bad file data version"
+	"Bad file data version",
+	"Bad item checksum",
+	"Duplicate item path"
 };
 
 /**
@@ -0,0 +1,99 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Layered Pack archive overlay.
+ *
+ * @details
+ * Used to mount several Pack readers on top of each other, for example a base pack with the DLC and hotfix packs.
+ * Each item path is resolved to the topmost pack that contains it. Paths of all mounted packs are merged into a
+ * single hash table once, on creation, so a lookup costs the same as in one pack, even if path is missing.
+ */
+
+#pragma once
+#include "pack/reader.h"
+
+/**
+ * @brief Pack overlay structure.
+ */
+typedef struct PackOverlay_T PackOverlay_T;
+/**
+ * @brief Pack overlay instance.
+ */
+typedef PackOverlay_T* PackOverlay;
+
+/**
+ * @brief Resolved Pack overlay item handle.
+ */
+typedef struct PackOverlayItem
+{
+	PackReader packReader; /**< Pack reader that contains the item */
+	uint64_t itemIndex;    /**< Item index inside the pack reader */
+	uint32_t packIndex;    /**< Mounted pack index, higher index has higher priority */
+} PackOverlayItem;
+
+/**
+ * @brief Creates a new Pack overlay instance.
+ *
+ * @details
+ * Pack readers are mounted in the array order, items of the later packs override items with the same path
+ * in the earlier ones. Overlay doesn't take ownership of the readers, they should be destroyed after it.
+ *
+ * @param[in] packReaders mounted pack reader array (from the base to the top)
+ * @param packCount mounted pack reader count
+ * @param[out] packOverlay pointer to the pack overlay instance
+ *
+ * @return The @ref PackResult code.
+ *
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval BAD_DATA_SIZE_PACK_RESULT if total item count is too big
+ */
+PackResult createPackOverlay(const PackReader* packReaders, uint32_t packCount, PackOverlay* packOverlay);
+/**
+ * @brief Destroys Pack overlay instance.
+ * @param packOverlay pack overlay instance or NULL
+ */
+void destroyPackOverlay(PackOverlay packOverlay);
+
+/**
+ * @brief Searches for the topmost pack item by its path. (MT-Safe)
+ * @details Merged lookup doesn't update the mounted pack reader lookup counters.
+ *
+ * @param packOverlay pack overlay instance
+ * @param[in] path item path string used to pack the file
+ * @param[out] item pointer to the resolved overlay item handle
+ *
+ * @return True if item is found in one of the mounted packs, otherwise false.
+ */
+bool getPackOverlayItem(PackOverlay packOverlay, const char* path, PackOverlayItem* item);
+
+/**
+ * @brief Returns unique item path count of all mounted packs. (MT-Safe)
+ * @param packOverlay pack overlay instance
+ */
+uint64_t getPackOverlayItemCount(PackOverlay packOverlay);
+/**
+ * @brief Returns mounted pack reader count. (MT-Safe)
+ * @param packOverlay pack overlay instance
+ */
+uint32_t getPackOverlayPackCount(PackOverlay packOverlay);
+/**
+ * @brief Returns mounted pack reader instance. (MT-Safe)
+ *
+ * @param packOverlay pack overlay instance
+ * @param packIndex mounted pack index
+ */
+PackReader getPackOverlayReader(PackOverlay packOverlay, uint32_t packIndex);
@@ -34,6 +34,79 @@ typedef struct PackReader_T PackReader_T;
  */
 typedef PackReader_T* PackReader;
 
+/**
+ * @brief Pack item stream structure.
+ */
+typedef struct PackItemStream_T PackItemStream_T;
+/**
+ * @brief Pack item stream instance.
+ */
+typedef PackItemStream_T* PackItemStream;
+
+/**
+ * @brief Pack read queue structure.
+ */
+typedef struct PackReadQueue_T PackReadQueue_T;
+/**
+ * @brief Pack read queue instance.
+ */
+typedef PackReadQueue_T* PackReadQueue;
+
+/**
+ * @brief Pack item read completion function.
+ * @details Called for each submitted item read after its data is read and decompressed.
+ *
+ * @param itemIndex uint64_t item index
+ * @param[in] buffer target buffer with the item data
+ * @param result item read @ref PackResult code
+ * @param[in] argument submitted item read argument
+ */
+typedef void(*OnPackItemRead)(uint64_t itemIndex, uint8_t* buffer, PackResult result, void* argument);
+
+/**
+ * @brief Pack reader access patterns.
+ * @enum
+ */
+typedef enum PackAccess_T
+{
+	NORMAL_PACK_ACCESS = 0,     /**< No special access pattern, OS default read-ahead */
+	RANDOM_PACK_ACCESS = 1,     /**< Items are read in a random order, read-ahead is disabled */
+	SEQUENTIAL_PACK_ACCESS = 2, /**< Items are read in the file order, read-ahead is increased */
+	PACK_ACCESS_COUNT = 3
+} PackAccess_T;
+/**
+ * @brief Pack reader access pattern.
+ */
+typedef uint8_t PackAccess;
+
+/**
+ * @brief Pack decompressed item cache statistics.
+ */
+typedef struct PackCacheStats
+{
+	uint64_t hitCount;      /**< Item reads served from the cache */
+	uint64_t missCount;     /**< Item reads that had to decompress data */
+	uint64_t evictionCount; /**< Items removed from the cache to fit the byte budget */
+	uint64_t itemCount;     /**< Currently cached item count */
+	uint64_t cachedSize;    /**< Currently cached item data size in bytes */
+} PackCacheStats;
+
+/**
+ * @brief Pack reader performance statistics.
+ * @details Times are measured with the monotonic clock in nanoseconds.
+ */
+typedef struct PackReaderStats
+{
+	uint64_t itemReadCount;   /**< Item data reads from the pack, excluding decompressed item cache hits */
+	uint64_t zipReadSize;     /**< Compressed item data size in bytes read from the pack */
+	uint64_t rawReadSize;     /**< Uncompressed item data size in bytes read from the pack */
+	uint64_t readTime;        /**< Time spent reading item data from the pack file */
+	uint64_t zipTime;         /**< Time spent decompressing item data */
+	uint64_t zipBufferSize;   /**< Largest compressed data buffer size in bytes (high-water mark) */
+	uint64_t lookupCount;     /**< Item path lookup count */
+	uint64_t lookupMissCount; /**< Item path lookups that didn't find an item */
+} PackReaderStats;
+
 /**
  * @brief Creates a new file pack reader instance.
  * 
@@ -41,6 +114,7 @@ typedef PackReader_T* PackReader;
  * The main function for opening Pack archives. It creates a new Pack reader instance and 
  * reads information about the  location of packed files in the file. Subsequently, 
  * it organizes this information for quick searching and reading data from the archive file. 
+ * Only one file descriptor is opened, all threads read data from it using positional reads.
  * 
  * @note You should destroy created Pack instance manually.
  *
@@ -68,6 +142,71 @@ typedef PackReader_T* PackReader;
 PackResult createFilePackReader(const char* filePath, uint32_t dataVersion,
 	bool isResourcesDirectory, uint32_t threadCount, PackReader* packReader);
 
+/**
+ * @brief Creates a new memory mapped pack reader instance.
+ * 
+ * @details
+ * Maps the whole Pack archive into the process address space instead of opening a file stream for each thread. 
+ * Compressed items are decompressed straight from the mapping and uncompressed items can be accessed without any 
+ * copy using the @ref getPackItemDataPointer(). Mapped pages are shared through the OS page cache between all 
+ * processes reading the same Pack file.
+ * 
+ * @note You should destroy created Pack instance manually.
+ *
+ * @param[in] filePath target Pack file path string
+ * @param dataVersion target packed file data version (0 = ignore data version)
+ * @param isResourcesDirectory read from the resources directory (Android/iOS/macOS only)
+ * @param threadCount max concurrent read thread count
+ * @param[out] packReader pointer to the Pack reader instance
+ * 
+ * @return The @ref PackResult code and writes reader instance on success.
+ * 
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval FAILED_TO_GET_DIRECTORY_PACK_RESULT if failed to get resources directory path
+ * @retval FAILED_TO_OPEN_FILE_PACK_RESULT if file doesn't exist
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT if failed to create ZSTD contexts
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT if failed to map or read Pack file data
+ * @retval BAD_FILE_TYPE_PACK_RESULT if file is not a Pack archive
+ * @retval BAD_FILE_VERSION_PACK_RESULT if different Pack file version
+ * @retval BAD_FILE_ENDIANNESS_PACK_RESULT if different Pack file data endianness
+ * @retval BAD_DATA_SIZE_PACK_RESULT if bad Pack file data size
+ * @retval BAD_FILE_DATA_VERSION_PACK_RESULT if bad packed file data version
+ */
+PackResult createMappedPackReader(const char* filePath, uint32_t dataVersion,
+	bool isResourcesDirectory, uint32_t threadCount, PackReader* packReader);
+
+/**
+ * @brief Creates a new pack reader instance from the caller owned memory buffer.
+ * 
+ * @details
+ * Reads Pack archive embedded into the executable, received over IPC or already resident in the shared memory, 
+ * without any file I/O. Buffer is used the same way as the @ref createMappedPackReader() mapping, so uncompressed 
+ * items can be accessed without any copy using the @ref getPackItemDataPointer().
+ * 
+ * @warning Buffer is not copied, it should stay valid and unchanged until the reader is destroyed.
+ * @note You should destroy created Pack instance manually.
+ *
+ * @param[in] data pack archive data buffer
+ * @param size pack archive data size in bytes
+ * @param dataVersion target packed file data version (0 = ignore data version)
+ * @param threadCount max concurrent read thread count
+ * @param[out] packReader pointer to the Pack reader instance
+ * 
+ * @return The @ref PackResult code and writes reader instance on success.
+ * 
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT if failed to create ZSTD contexts
+ * @retval BAD_FILE_TYPE_PACK_RESULT if data is not a Pack archive
+ * @retval BAD_FILE_VERSION_PACK_RESULT if different Pack file version
+ * @retval BAD_FILE_ENDIANNESS_PACK_RESULT if different Pack file data endianness
+ * @retval BAD_DATA_SIZE_PACK_RESULT if bad Pack data size
+ * @retval BAD_FILE_DATA_VERSION_PACK_RESULT if bad packed file data version
+ */
+PackResult createMemoryPackReader(const void* data, size_t size, 
+	uint32_t dataVersion, uint32_t threadCount, PackReader* packReader);
+
 /**
  * @brief Destroys Pack reader instance.
  * @param packReader pack reader instance or NULL
@@ -120,7 +259,7 @@ uint32_t getPackItemDataSize(PackReader packReader, uint64_t index);
  * 
  * @return The data binary size, or 0 if item is not compressed.
  * @retval Integer between 1 and 4,294,967,295 if compressed. (4GB)
- * @retval 0 if item is not compressed
+ * @retval 0 if item is not compressed or stored inside the solid block
  */
 uint32_t getPackItemZipSize(PackReader packReader, uint64_t index);
 
@@ -141,14 +280,255 @@ uint32_t getPackItemZipSize(PackReader packReader, uint64_t index);
  * @retval SUCCESS_PACK_RESULT - successful operation
  * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
  * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to read Pack file data
- * @retval FAILED_TO_SEEK_FILE_PACK_RESULT - failed to seek Pack file data
  * @retval FAILED_TO_DECOMPRESS_PACK_RESULT - compressed file data is damaged
+ * @retval BAD_ITEM_CHECKSUM_PACK_RESULT - item data is damaged (if verification is enabled)
  */
 PackResult readPackItemData(PackReader packReader, uint64_t itemIndex, uint8_t* buffer, uint32_t threadIndex);
 
+/**
+ * @brief Reads Pack item binary data from any thread. (MT-Safe)
+ * 
+ * @details
+ * Same as the @ref readPackItemData() but without the thread index. Decompression context and scratch buffer are 
+ * taken from the internal lock-free pool of the threadCount size, and file data is read using positional reads 
+ * on the one shared file descriptor. If all pooled contexts are busy, a temporary one is created for this call.
+ *
+ * @param packReader pack reader instance
+ * @param itemIndex uint64_t item index
+ * @param[out] buffer target buffer where to read the item data
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT - failed to create temporary ZSTD context
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to read Pack file data
+ * @retval FAILED_TO_DECOMPRESS_PACK_RESULT - compressed file data is damaged
+ * @retval BAD_ITEM_CHECKSUM_PACK_RESULT - item data is damaged (if verification is enabled)
+ */
+PackResult readPackItemDataConcurrent(PackReader packReader, uint64_t itemIndex, uint8_t* buffer);
+
+/**
+ * @brief Reads part of the Pack item binary data. (MT-Safe)
+ * 
+ * @details
+ * Compressed items bigger than the @ref PACK_FRAME_SIZE are split into independent frames, so only frames 
+ * that cover the requested range are read and decompressed. Smaller compressed items are decompressed whole.
+ * Decompression context and scratch buffer are taken from the same pool as in @ref readPackItemDataConcurrent().
+ * @note Item data range can't be verified with the item checksum, see the @ref setPackReaderVerify().
+ *
+ * @param packReader pack reader instance
+ * @param itemIndex uint64_t item index
+ * @param offset item data offset in bytes
+ * @param length read data length in bytes (offset + length <= item data size)
+ * @param[out] buffer target buffer where to read the item data range
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT - failed to create temporary ZSTD context
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to read Pack file data
+ * @retval FAILED_TO_DECOMPRESS_PACK_RESULT - compressed file data is damaged
+ */
+PackResult readPackItemRange(PackReader packReader, uint64_t itemIndex, 
+	uint32_t offset, uint32_t length, uint8_t* buffer);
+
+/**
+ * @brief Reads multiple Pack items binary data. (MT-Safe)
+ * 
+ * @details
+ * Sorts requested items by their location in the archive file and merges nearby data blocks into larger 
+ * reads, which turns many random seeks into a mostly sequential sweep. Useful when loading thousands 
+ * of items at once, for example during the level loading.
+ *
+ * @param packReader pack reader instance
+ * @param[in] itemIndices uint64_t item index array
+ * @param[out] buffers target buffer array where to read the items data (same order as indices)
+ * @param itemCount item index and buffer array size
+ * @param threadIndex current thread index or 0
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to read Pack file data
+ * @retval FAILED_TO_DECOMPRESS_PACK_RESULT - compressed file data is damaged
+ * @retval BAD_ITEM_CHECKSUM_PACK_RESULT - item data is damaged (if verification is enabled)
+ */
+PackResult readPackItemsBatch(PackReader packReader, const uint64_t* itemIndices,
+	uint8_t** buffers, uint64_t itemCount, uint32_t threadIndex);
+
+/**
+ * @brief Hints OS to start loading Pack items data in the background. (MT-Safe)
+ * 
+ * @details
+ * Issues read-ahead requests (fadvise / madvise) for the file ranges of the upcoming items, so the following 
+ * item reads hit the OS page cache instead of waiting for the disk. Nearby item ranges are merged like in 
+ * the @ref readPackItemsBatch(). Does not block on the I/O and does not decompress anything.
+ * 
+ * @note Prefetching is only a hint, it is silently ignored if not supported by the platform. On Windows only 
+ *       the mapped pack reader prefetches data (PrefetchVirtualMemory, Windows 8+), for the file reader it is no-op.
+ *
+ * @param packReader pack reader instance
+ * @param[in] itemIndices uint64_t item index array
+ * @param itemCount item index array size
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ */
+PackResult prefetchPackItems(PackReader packReader, const uint64_t* itemIndices, uint64_t itemCount);
+
+/**
+ * @brief Returns Pack item binary data pointer inside the mapped archive. (MT-Safe)
+ * 
+ * @details
+ * Allows to access uncompressed item data without copying it to the separate buffer. 
+ * Returned memory block size is equal to the @ref getPackItemDataSize().
+ * @warning You should not modify or free the returned data, it's valid until the reader is destroyed.
+ *
+ * @param packReader pack reader instance
+ * @param index uint64_t item index
+ * 
+ * @return Pointer to the item data, or NULL if reader is not mapped (or memory) or item is compressed (or solid).
+ */
+const uint8_t* getPackItemDataPointer(PackReader packReader, uint64_t index);
+
+/***********************************************************************************************************************
+ * @brief Opens a new Pack item data stream. (MT-Safe)
+ * 
+ * @details
+ * Allows to read large item data in small chunks, without allocating buffers of the whole item size. Compressed 
+ * data is read from the file in small blocks and decompressed incrementally, so memory consumption is bounded 
+ * by the compression window instead of the item size. Consumer can start processing data right away.
+ * 
+ * @note You should close opened Pack item stream manually, before destroying the Pack reader.
+ * @warning Item stream instance should be used only from one thread at the same time.
+ *
+ * @param packReader pack reader instance
+ * @param itemIndex uint64_t item index
+ * @param[out] itemStream pointer to the Pack item stream instance
+ * 
+ * @return The @ref PackResult code and writes item stream instance on success.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT - failed to create decompression context
+ */
+PackResult openPackItemStream(PackReader packReader, uint64_t itemIndex, PackItemStream* itemStream);
+/**
+ * @brief Closes Pack item data stream.
+ * @param itemStream pack item stream instance or NULL
+ */
+void closePackItemStream(PackItemStream itemStream);
+
+/**
+ * @brief Reads next Pack item data chunk from the stream.
+ * @details Fills the whole buffer, unless the end of the item data is reached.
+ *
+ * @param itemStream pack item stream instance
+ * @param[out] buffer target buffer where to read the item data chunk
+ * @param bufferSize target buffer size in bytes
+ * @param[out] readSize pointer to the read data size in bytes (0 = end of the item data)
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to read Pack file data
+ * @retval FAILED_TO_DECOMPRESS_PACK_RESULT - compressed file data is damaged
+ * @retval BAD_ITEM_CHECKSUM_PACK_RESULT - item data is damaged (if verification is enabled)
+ */
+PackResult readPackItemStream(PackItemStream itemStream, uint8_t* buffer, uint32_t bufferSize, uint32_t* readSize);
+
+/**
+ * @brief Returns Pack item stream read data offset in bytes.
+ * @param itemStream pack item stream instance
+ */
+uint32_t getPackItemStreamOffset(PackItemStream itemStream);
+
+/***********************************************************************************************************************
+ * @brief Creates a new Pack read queue instance.
+ * 
+ * @details
+ * Allows to keep many item reads in flight from a one thread instead of blocking on each of them. On Linux, when built 
+ * with the PACK_USE_IO_URING option, reads are submitted to the kernel through the io_uring and items are 
+ * decompressed as their completions arrive. Otherwise, or if io_uring is not available at runtime, each 
+ * item is read synchronously on submit. Memory mapped readers always use synchronous reads.
+ * 
+ * @note You should destroy created Pack read queue manually, before destroying the Pack reader.
+ * @warning Read queue instance should be used only from one thread at the same time.
+ *
+ * @param packReader pack reader instance
+ * @param queueDepth max in flight item read count
+ * @param[in] onItemRead item read completion function
+ * @param[out] readQueue pointer to the Pack read queue instance
+ * 
+ * @return The @ref PackResult code and writes read queue instance on success.
+ * 
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT if failed to create ZSTD context
+ */
+PackResult createPackReadQueue(PackReader packReader, uint32_t queueDepth, 
+	OnPackItemRead onItemRead, PackReadQueue* readQueue);
+/**
+ * @brief Destroys Pack read queue instance.
+ * @details Waits for all pending item reads to complete, calling completion function for each of them.
+ * @param readQueue pack read queue instance or NULL
+ */
+void destroyPackReadQueue(PackReadQueue readQueue);
+
+/**
+ * @brief Submits a new Pack item read to the queue.
+ * 
+ * @details
+ * Item read result is passed to the queue completion function. Submitted reads are sent to the kernel on the 
+ * next @ref processPackReadQueue() call, or when all queue slots are in flight. In the second case this 
+ * function waits for at least one read completion before returning.
+ * @warning Target buffer should stay valid until the item read completion function is called.
+ *
+ * @param readQueue pack read queue instance
+ * @param itemIndex uint64_t item index
+ * @param[out] buffer target buffer where to read the item data
+ * @param[in] argument completion function argument or NULL
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to submit read to the kernel
+ */
+PackResult submitPackItemRead(PackReadQueue readQueue, uint64_t itemIndex, uint8_t* buffer, void* argument);
+
+/**
+ * @brief Submits queued Pack item reads and handles arrived completions.
+ *
+ * @param readQueue pack read queue instance
+ * @param waitAll wait until all pending item reads are completed
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT - failed to submit reads to the kernel
+ */
+PackResult processPackReadQueue(PackReadQueue readQueue, bool waitAll);
+
+/**
+ * @brief Returns Pack read queue submitted but not yet completed item read count.
+ * @param readQueue pack read queue instance
+ */
+uint32_t getPackReadQueuePendingCount(PackReadQueue readQueue);
+/**
+ * @brief Returns true if Pack read queue uses asynchronous io_uring backend.
+ * @param readQueue pack read queue instance
+ */
+bool isPackReadQueueAsync(PackReadQueue readQueue);
+
 /***********************************************************************************************************************
  * @brief Returns Pack item data offset in the archive file. (MT-Safe)
- * @details Internally used to read an item data from the archive file.
+ * @details Internally used to read an item data from the archive file. Solid items return their block offset.
  *
  * @param packReader pack reader instance
  * @param index uint64_t item index
@@ -167,6 +547,40 @@ uint64_t getPackItemFileOffset(PackReader packReader, uint64_t index);
  * @return True if item is a reference, otherwise false.
  */
 bool isPackItemReference(PackReader packReader, uint64_t index);
+/**
+ * @brief Returns true if pack item is compressed with fast-read algorithm. (MT-Safe)
+ * @details Each item can be compressed with a different algorithm, see the @ref PackItemHeader.
+ *
+ * @param packReader pack reader instance
+ * @param index uint64_t item index
+ * 
+ * @return True if item is compressed with LZ4, otherwise false. (ZSTD or not compressed)
+ */
+bool isPackItemPreferSpeed(PackReader packReader, uint64_t index);
+/**
+ * @brief Returns true if pack item is stored inside the solid block. (MT-Safe)
+ * 
+ * @details
+ * Small items can be compressed together in the shared blocks, see the @ref PackBlockHeader. 
+ * Recently decompressed blocks are cached by the reader, so sibling items are read without decompression.
+ *
+ * @param packReader pack reader instance
+ * @param index uint64_t item index
+ * 
+ * @return True if item is stored inside the solid block, otherwise false.
+ */
+bool isPackItemSolid(PackReader packReader, uint64_t index);
+/**
+ * @brief Returns Pack item data checksum. (MT-Safe)
+ * @details See the @ref computePackChecksum(). Packs created by the older library versions have no checksums.
+ *
+ * @param packReader pack reader instance
+ * @param index uint64_t item index
+ * @param[out] checksum pointer to the uint32_t item data checksum
+ * 
+ * @return True if pack contains item checksums and writes checksum, otherwise false.
+ */
+bool getPackItemChecksum(PackReader packReader, uint64_t index, uint32_t* checksum);
 
 /**
  * @brief Returns Pack item path string. (MT-Safe)
@@ -181,16 +595,24 @@ bool isPackItemReference(PackReader packReader, uint64_t index);
 const char* getPackItemPath(PackReader packReader, uint64_t index);
 
 /**
- * @brief Returns true if data was compressed with fast-read algorithm. (MT-Safe)
+ * @brief Returns true if data was compressed with fast-read algorithm by default. (MT-Safe)
+ * @details Items can override the default algorithm, see the @ref isPackItemPreferSpeed().
  * @param packReader pack reader instance
  */
 bool isPackPreferSpeed(PackReader packReader);
+/**
+ * @brief Returns true if Pack archive is mapped into the memory. (MT-Safe)
+ * @details Also returns true for the @ref createMemoryPackReader() readers.
+ * @param packReader pack reader instance
+ */
+bool isPackReaderMapped(PackReader packReader);
 
 /**
  * @brief Returns Pack ZSTD context array. (MT-Safe)
  * @details Can be used to share the ZSTD contexts in the program.
  * @param packReader pack reader instance
  * @return Array of the ZSTD_DCtx* contexts.
+ * @warning Aborts if the pack has no ZSTD compressed items and prefers speed.
  */
 void** const getPackZstdContexts(PackReader packReader);
 /**
@@ -201,15 +623,105 @@ uint32_t getPackThreadCount(PackReader packReader);
 
 /**
  * @brief Reduces internal Pack reader memory consumption.
+ * @details Also evicts all items from the decompressed item cache.
  * @param packReader pack reader instance
  */
 void shrinkPack(PackReader packReader);
 
+/**
+ * @brief Declares Pack reader item access pattern.
+ * 
+ * @details
+ * Tunes OS read-ahead for the pack file or mapping. Use random access for the scattered item reads 
+ * (avoids reading unneeded data around items) and sequential for the whole pack sweeps (unpacking, loading).
+ * @note Access pattern is only a hint, it is silently ignored if not supported by the platform.
+ *
+ * @param packReader pack reader instance
+ * @param access item access pattern
+ */
+void setPackReaderAccess(PackReader packReader, PackAccess access);
+/**
+ * @brief Returns Pack reader declared item access pattern. (MT-Safe)
+ * @param packReader pack reader instance
+ */
+PackAccess getPackReaderAccess(PackReader packReader);
+
+/**
+ * @brief Enables or disables Pack item data verification on read.
+ * 
+ * @details
+ * Read item data is compared with the item checksum stored in the pack index, damaged (by disk or transfer 
+ * errors) items are then reported with the BAD_ITEM_CHECKSUM_PACK_RESULT instead of returning bad data. 
+ * It applies to the whole item reads, batch reads, read queue and streams (checked at the end of the item). 
+ * Checksum is computed with the hardware CRC32C instructions, so it's cheap enough to be always enabled.
+ * @note Does nothing if pack has no item checksums, see the @ref getPackItemChecksum().
+ *
+ * @param packReader pack reader instance
+ * @param verifyChecksums verify item data checksums
+ */
+void setPackReaderVerify(PackReader packReader, bool verifyChecksums);
+/**
+ * @brief Returns true if Pack reader verifies item data checksums. (MT-Safe)
+ * @param packReader pack reader instance
+ */
+bool isPackReaderVerify(PackReader packReader);
+
+/***********************************************************************************************************************
+ * @brief Enables Pack decompressed item cache.
+ * 
+ * @details
+ * Keeps recently decompressed items in memory, so repeated reads of the same item skip the file read and 
+ * decompression. Cache is split into the shards with separate locks, to not serialize concurrent readers, 
+ * and items are evicted using the CLOCK algorithm once the byte budget is exceeded. Only compressed 
+ * items are cached, uncompressed item data is already served from the OS page cache.
+ * 
+ * @note Cached item data is copied to the target buffer, so it's still owned by the caller.
+ * @warning This function is not thread-safe, call it before reading items from the other threads.
+ *
+ * @param packReader pack reader instance
+ * @param capacity max cached item data size in bytes (0 = disable cache)
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT - successful operation
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT - out of memory
+ */
+PackResult setPackItemCacheCapacity(PackReader packReader, uint64_t capacity);
+/**
+ * @brief Returns Pack decompressed item cache capacity in bytes, or 0 if cache is disabled. (MT-Safe)
+ * @param packReader pack reader instance
+ */
+uint64_t getPackItemCacheCapacity(PackReader packReader);
+/**
+ * @brief Returns Pack decompressed item cache statistics. (MT-Safe)
+ * @details All statistic values are zero if cache is disabled.
+ *
+ * @param packReader pack reader instance
+ * @param[out] stats pointer to the cache statistics
+ */
+void getPackItemCacheStats(PackReader packReader, PackCacheStats* stats);
+
+/**
+ * @brief Returns Pack reader performance statistics. (MT-Safe)
+ * 
+ * @details
+ * Each reader thread updates its own counters, they are summed on query. Values are 
+ * accumulated since the reader creation, subtract previous query values to get the rates.
+ * Mapped pack reads have no separate I/O, their time is counted as the decompression or read time.
+ * Asynchronous read queue I/O time is not counted, because reads are overlapped.
+ *
+ * @param packReader pack reader instance
+ * @param[out] stats pointer to the reader statistics
+ */
+void getPackReaderStats(PackReader packReader, PackReaderStats* stats);
+
 /***********************************************************************************************************************
  * @brief Unpacks files from the pack. (MT-Safe)
  * @details This function is useful when we need to create a unpacker for debugging a program.
+ * Items are unpacked from the multiple threads, uncompressed items are copied by the OS kernel if supported.
  *
  * @param[in] filePath target Pack file path string
+ * @param threadCount item unpacking thread count (including calling thread)
  * @param printProgress output unpacking progress to the stdout
  * 
  * @return The @ref PackResult code and unpacks files on success.
@@ -227,4 +739,32 @@ void shrinkPack(PackReader packReader);
  * @retval BAD_DATA_SIZE_PACK_RESULT if bad Pack file data size
  * @retval BAD_FILE_DATA_VERSION_PACK_RESULT if bad packed file data version
  */
-PackResult unpackFiles(const char* filePath, bool printProgress);
\ No newline at end of file
+PackResult unpackFiles(const char* filePath, uint32_t threadCount, bool printProgress);
+
+/**
+ * @brief Verifies all items of the pack. (MT-Safe)
+ * 
+ * @details
+ * Reads and decompresses every item from the multiple threads and compares it with the item checksum.
+ * All items are checked even if some of them are damaged, damaged items are printed if printProgress is set.
+ * Packs without item checksums are only checked for the decompression errors.
+ *
+ * @param[in] filePath target Pack file path string
+ * @param threadCount item verification thread count (including calling thread)
+ * @param printProgress output verification progress and damaged items to the stdout
+ * 
+ * @return The @ref PackResult code.
+ *
+ * @retval SUCCESS_PACK_RESULT if all items are valid
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval FAILED_TO_OPEN_FILE_PACK_RESULT if file doesn't exist
+ * @retval FAILED_TO_CREATE_ZSTD_PACK_RESULT if failed to create ZSTD contexts
+ * @retval FAILED_TO_READ_FILE_PACK_RESULT if failed to read Pack file data
+ * @retval FAILED_TO_DECOMPRESS_PACK_RESULT if compressed item data is damaged
+ * @retval BAD_ITEM_CHECKSUM_PACK_RESULT if item data checksum mismatch
+ * @retval BAD_FILE_TYPE_PACK_RESULT if file is not a Pack archive
+ * @retval BAD_FILE_VERSION_PACK_RESULT if different Pack file version
+ * @retval BAD_FILE_ENDIANNESS_PACK_RESULT if different Pack file data endianness
+ * @retval BAD_DATA_SIZE_PACK_RESULT if bad Pack file data size
+ */
+PackResult verifyPackFiles(const char* filePath, uint32_t threadCount, bool printProgress);
\ No newline at end of file
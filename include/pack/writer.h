@@ -27,12 +27,48 @@
 
 /**
  * @brief File packing callback.
+ * @note It's called from the packing function thread in the item data order, even if threadCount > 1.
  * 
  * @param itemIndex current packing item index
  * @param argument callback agument, or NULL
  */
 typedef void(*OnPackFile)(uint64_t itemIndex, void* argument);
 
+/***********************************************************************************************************************
+ * @brief Pack item compression types.
+ * @enum
+ */
+typedef enum PackZipType_T
+{
+	DEFAULT_PACK_ZIP_TYPE = 0,
+	NONE_PACK_ZIP_TYPE = 1,
+	ZSTD_PACK_ZIP_TYPE = 2,
+	LZ4_PACK_ZIP_TYPE = 3,
+	PACK_ZIP_TYPE_COUNT = 4
+} PackZipType_T;
+/**
+ * @brief Pack item compression type.
+ */
+typedef uint8_t PackZipType;
+
+/**
+ * @brief Item compression type selection callback.
+ * 
+ * @details
+ * Allows to store latency critical items with the fast-read algorithm (LZ4), bulk items with maximum 
+ * compression (ZSTD) and already compressed items as is, inside the one Pack archive. 
+ * DEFAULT_PACK_ZIP_TYPE uses the packing function preferSpeed algorithm.
+ * 
+ * @warning It's called from the file compression threads, if threadCount > 1.
+ * 
+ * @param[in] itemPath packing item path string
+ * @param dataSize packing item data size in bytes
+ * @param argument callback agument, or NULL
+ * 
+ * @return The @ref PackZipType for the item.
+ */
+typedef PackZipType(*OnPackItemZip)(const char* itemPath, uint32_t dataSize, void* argument);
+
 /**
  * @brief Packs files to the Pack archive.
  * 
@@ -41,6 +77,30 @@ typedef void(*OnPackFile)(uint64_t itemIndex, void* argument);
  * possible compression. You can speed up the runtime file decompression by specifying a zipThreshold value, as if 
  * after compression, we achieve only 10% compression, then decompression will consume more resources than we 
  * save on file size. The optimal float value for the zipThreshold is 0.1f.
+ * 
+ * Packs with many small similar files (configs, shaders, materials...) compress poorly one by one, 
+ * you can set useDictionary to train a shared dictionary over the files and store it inside the archive. 
+ * It's loaded once by the reader, improving both compression ratio and small item decompression speed.
+ * 
+ * Files are read and compressed by the threadCount worker threads, while the calling thread writes 
+ * them to the archive in the original order. The output file is the same for any thread count.
+ * 
+ * Item data is laid out in the item path order by default. You can pass an access trace, the item paths 
+ * recorded in the order they are read at runtime (for example during a level load), then the item data is 
+ * laid out in their first access order, followed by the not traced items. It turns the traced load into one 
+ * mostly sequential sweep of the file, which greatly helps on HDDs and cold page cache. Unknown trace paths 
+ * are ignored. Index and lookup are not affected by the trace.
+ * 
+ * Packs with thousands of tiny files waste space and decompression time on the per item frame overhead. 
+ * You can set solidThreshold to compress compressed items up to this size together in shared solid blocks 
+ * (up to the @ref PACK_BLOCK_SIZE), grouped by the item directory. Not traced items are then laid out in the 
+ * directory order, so sibling items share the block. Solid items are not deduplicated.
+ * 
+ * Compression algorithm can be selected for each item with the onItemZip callback, 
+ * otherwise all items are compressed with the preferSpeed algorithm.
+ * 
+ * You can set useChecksums to store the CRC32C checksum of each item data in the index, 
+ * then the reader can detect damaged items if the verification is enabled.
  *
  * @param[in] packPath output Pack file path string
  * @param fileCount file count to pack
@@ -48,11 +108,158 @@ typedef void(*OnPackFile)(uint64_t itemIndex, void* argument);
  * @param dataVersion packed file data version
  * @param zipThreshold compression threshold (0.0 - 1.0 range)
  * @param preferSpeed prefer faster decompression algorithm (sacrificing size)
+ * @param useDictionary train and use compression dictionary for the packed files
+ * @param useChecksums compute and store item data checksums
+ * @param threadCount file compression thread count (1 = single threaded)
  * @param printProgress output packing progress to the stdout
+ * @param solidThreshold maximum solid item data size in bytes (0 = no solid blocks)
+ * @param traceCount item access trace path count (0 = no trace)
+ * @param[in] traceItemPaths item access trace path string array, or NULL
  * @param[in] onPackFile file packing callback, or NULL
- * @param[in] argument file packing callback argument, or NULL
+ * @param[in] onItemZip item compression type callback, or NULL
+ * @param[in] argument file packing and item compression callback argument, or NULL
  * 
  * @return The @ref PackResult code.
  */
 PackResult packFiles(const char* packPath, uint64_t fileCount, const char** fileItemPaths, uint32_t dataVersion, 
-	float zipThreshold, bool preferSpeed, bool printProgress, OnPackFile onPackFile, void* argument);
\ No newline at end of file
+	float zipThreshold, bool preferSpeed, bool useDictionary, bool useChecksums, uint32_t threadCount, 
+	bool printProgress, uint32_t solidThreshold, uint64_t traceCount, const char** traceItemPaths, 
+	OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument);
+
+/**
+ * @brief Updates files in the existing Pack archive.
+ * 
+ * @details
+ * Writes a new Pack archive with all items of the base pack, where the provided files are added or replace 
+ * base items with the same item path. Unchanged items are copied as is without recompression, so only the 
+ * changed files are compressed. The default compression algorithm and dictionary are taken from the base pack.
+ * 
+ * If packPath points to the same file as the basePackPath, the updated pack is written to the temporary 
+ * "<packPath>.tmp" file, which atomically replaces the base pack only on success.
+ * Item data is laid out using the access trace the same way as in the @ref packFiles(). 
+ * Unchanged solid items are regrouped into the new solid blocks.
+ *
+ * @param[in] packPath output Pack file path string
+ * @param[in] basePackPath existing Pack file path string
+ * @param fileCount changed file count (can be 0)
+ * @param[in] fileItemPaths changed file and item path string array (file/item, file/item...)
+ * @param dataVersion packed file data version
+ * @param zipThreshold compression threshold (0.0 - 1.0 range)
+ * @param useChecksums compute and store item data checksums
+ * @param threadCount file compression thread count (1 = single threaded)
+ * @param printProgress output packing progress to the stdout
+ * @param solidThreshold maximum solid item data size in bytes (0 = no solid blocks)
+ * @param traceCount item access trace path count (0 = no trace)
+ * @param[in] traceItemPaths item access trace path string array, or NULL
+ * @param[in] onPackFile file packing callback, or NULL
+ * @param[in] onItemZip item compression type callback, or NULL
+ * @param[in] argument file packing and item compression callback argument, or NULL
+ * 
+ * @return The @ref PackResult code.
+ */
+PackResult updatePackFiles(const char* packPath, const char* basePackPath, uint64_t fileCount, 
+	const char** fileItemPaths, uint32_t dataVersion, float zipThreshold, bool useChecksums, uint32_t threadCount, 
+	bool printProgress, uint32_t solidThreshold, uint64_t traceCount, const char** traceItemPaths, 
+	OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument);
+
+/***********************************************************************************************************************
+ * @brief Pack writer structure.
+ */
+typedef struct PackWriter_T PackWriter_T;
+/**
+ * @brief Pack writer instance.
+ */
+typedef PackWriter_T* PackWriter;
+
+/**
+ * @brief Creates a new incremental Pack writer instance.
+ * 
+ * @details
+ * Collects items one by one, from the files or straight from the memory, for example assets generated by the 
+ * pipeline, without writing them to the intermediate files. Items are compressed and written to the Pack archive 
+ * by the @ref finishPackWriter() the same way as in the @ref packFiles(), which describes the packing parameters.
+ * 
+ * @note You should destroy created Pack writer instance manually.
+ *
+ * @param[in] packPath output Pack file path string
+ * @param dataVersion packed file data version
+ * @param zipThreshold compression threshold (0.0 - 1.0 range)
+ * @param preferSpeed prefer faster decompression algorithm (sacrificing size)
+ * @param useDictionary train and use compression dictionary for the packed items
+ * @param useChecksums compute and store item data checksums
+ * @param threadCount item compression thread count (1 = single threaded)
+ * @param solidThreshold maximum solid item data size in bytes (0 = no solid blocks)
+ * @param[out] packWriter pointer to the Pack writer instance
+ * 
+ * @return The @ref PackResult code and writes writer instance on success.
+ * 
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ */
+PackResult createPackWriter(const char* packPath, uint32_t dataVersion, float zipThreshold, bool preferSpeed, 
+	bool useDictionary, bool useChecksums, uint32_t threadCount, uint32_t solidThreshold, PackWriter* packWriter);
+/**
+ * @brief Destroys Pack writer instance.
+ * @param packWriter pack writer instance or NULL
+ */
+void destroyPackWriter(PackWriter packWriter);
+
+/**
+ * @brief Adds a new item with the memory data to the Pack writer.
+ * @details Item data is copied, so the buffer can be freed right after the call.
+ * @note Item paths should be unique, a duplicate item path is rejected.
+ *
+ * @param packWriter pack writer instance
+ * @param[in] itemPath item path string inside the pack
+ * @param[in] data item data buffer
+ * @param dataSize item data size in bytes
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval BAD_DATA_SIZE_PACK_RESULT if item path is too long or data is empty
+ * @retval DUPLICATE_ITEM_PATH_PACK_RESULT if item path is already added
+ */
+PackResult addPackItemData(PackWriter packWriter, const char* itemPath, const void* data, uint32_t dataSize);
+/**
+ * @brief Adds a new item with the file data to the Pack writer.
+ * @details File is read only by the @ref finishPackWriter(), so it should exist until then.
+ * @note Item paths should be unique, a duplicate item path is rejected.
+ *
+ * @param packWriter pack writer instance
+ * @param[in] filePath packing file path string
+ * @param[in] itemPath item path string inside the pack
+ * 
+ * @return The @ref PackResult code.
+ * 
+ * @retval SUCCESS_PACK_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_PACK_RESULT if out of memory
+ * @retval BAD_DATA_SIZE_PACK_RESULT if item path is too long
+ * @retval DUPLICATE_ITEM_PATH_PACK_RESULT if item path is already added
+ */
+PackResult addPackItemFile(PackWriter packWriter, const char* filePath, const char* itemPath);
+
+/**
+ * @brief Writes all added Pack writer items to the Pack archive.
+ * @details Item data is laid out using the access trace the same way as in the @ref packFiles().
+ *
+ * @param packWriter pack writer instance
+ * @param printProgress output packing progress to the stdout
+ * @param traceCount item access trace path count (0 = no trace)
+ * @param[in] traceItemPaths item access trace path string array, or NULL
+ * @param[in] onPackFile item packing callback, or NULL
+ * @param[in] onItemZip item compression type callback, or NULL
+ * @param[in] argument item packing and item compression callback argument, or NULL
+ * 
+ * @return The @ref PackResult code.
+ * @retval BAD_DATA_SIZE_PACK_RESULT if there are no added items
+ */
+PackResult finishPackWriter(PackWriter packWriter, bool printProgress, uint64_t traceCount, 
+	const char** traceItemPaths, OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument);
+
+/**
+ * @brief Returns added Pack writer item count.
+ * @param packWriter pack writer instance
+ */
+uint64_t getPackWriterItemCount(PackWriter packWriter);
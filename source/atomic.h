@@ -0,0 +1,129 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Internal Pack library atomic operations.
+ * @details Minimal portable wrappers over the compiler intrinsics, C99 has no standard atomics.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Atomically loads 32-bit value with acquire semantics.
+ * @param[in] value pointer to the atomic value
+ */
+inline static int32_t atomicLoad32(volatile int32_t* value)
+{
+	#if _MSC_VER
+	return _InterlockedOr((volatile long*)value, 0);
+	#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+	#endif
+}
+/**
+ * @brief Atomically stores 32-bit value with release semantics.
+ *
+ * @param[out] value pointer to the atomic value
+ * @param desired new value
+ */
+inline static void atomicStore32(volatile int32_t* value, int32_t desired)
+{
+	#if _MSC_VER
+	_InterlockedExchange((volatile long*)value, (long)desired);
+	#else
+	__atomic_store_n(value, desired, __ATOMIC_RELEASE);
+	#endif
+}
+/**
+ * @brief Atomically replaces 32-bit value if it is equal to the expected one.
+ *
+ * @param[in,out] value pointer to the atomic value
+ * @param expected expected current value
+ * @param desired new value
+ *
+ * @return True if value has been replaced, otherwise false.
+ */
+inline static bool atomicCompareExchange32(volatile int32_t* value, int32_t expected, int32_t desired)
+{
+	#if _MSC_VER
+	return _InterlockedCompareExchange((volatile long*)value, (long)desired, (long)expected) == (long)expected;
+	#else
+	return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	#endif
+}
+/**
+ * @brief Atomically adds to the 32-bit value and returns previous one.
+ *
+ * @param[in,out] value pointer to the atomic value
+ * @param addend value to add
+ */
+inline static int32_t atomicFetchAdd32(volatile int32_t* value, int32_t addend)
+{
+	#if _MSC_VER
+	return _InterlockedExchangeAdd((volatile long*)value, (long)addend);
+	#else
+	return __atomic_fetch_add(value, addend, __ATOMIC_ACQ_REL);
+	#endif
+}
+/**
+ * @brief Atomically loads 64-bit value with acquire semantics.
+ * @param[in] value pointer to the atomic value
+ */
+inline static int64_t atomicLoad64(volatile int64_t* value)
+{
+	#if _MSC_VER
+	return _InterlockedOr64((volatile long long*)value, 0);
+	#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+	#endif
+}
+/**
+ * @brief Atomically replaces 64-bit value if it is equal to the expected one.
+ *
+ * @param[in,out] value pointer to the atomic value
+ * @param expected expected current value
+ * @param desired new value
+ *
+ * @return True if value has been replaced, otherwise false.
+ */
+inline static bool atomicCompareExchange64(volatile int64_t* value, int64_t expected, int64_t desired)
+{
+	#if _MSC_VER
+	return _InterlockedCompareExchange64((volatile long long*)value, 
+		(long long)desired, (long long)expected) == (long long)expected;
+	#else
+	return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	#endif
+}
+/**
+ * @brief Atomically adds to the 64-bit value and returns previous one.
+ *
+ * @param[in,out] value pointer to the atomic value
+ * @param addend value to add
+ */
+inline static int64_t atomicFetchAdd64(volatile int64_t* value, int64_t addend)
+{
+	#if _MSC_VER
+	return _InterlockedExchangeAdd64((volatile long long*)value, (long long)addend);
+	#else
+	return __atomic_fetch_add(value, addend, __ATOMIC_ACQ_REL);
+	#endif
+}
@@ -0,0 +1,224 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Internal Linux io_uring ring functions.
+ * @details Minimal raw system call based ring implementation, so we don't need the liburing dependency.
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+/**
+ * @brief Linux io_uring submission and completion rings.
+ */
+typedef struct PackUring
+{
+	uint8_t* sqRing;
+	uint8_t* cqRing;
+	struct io_uring_sqe* sqes;
+	struct io_uring_cqe* cqes;
+	uint32_t* sqHead;
+	uint32_t* sqTail;
+	uint32_t* sqArray;
+	uint32_t* cqHead;
+	uint32_t* cqTail;
+	size_t sqRingSize;
+	size_t cqRingSize;
+	size_t sqesSize;
+	uint32_t sqMask;
+	uint32_t cqMask;
+	uint32_t sqEntryCount;
+	uint32_t unsubmittedCount;
+	int ringFile;
+} PackUring;
+
+/**
+ * @brief Creates a new io_uring instance.
+ * @return True on success, otherwise false. (ex. old kernel or blocked by the seccomp)
+ *
+ * @param entryCount submission queue entry count
+ * @param[out] ring pointer to the ring structure
+ */
+inline static bool createPackUring(uint32_t entryCount, PackUring* ring)
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(struct io_uring_params));
+	memset(ring, 0, sizeof(PackUring));
+
+	int ringFile = (int)syscall(__NR_io_uring_setup, entryCount, &params);
+	if (ringFile < 0)
+		return false;
+
+	size_t sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	size_t cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (isSingleMap)
+		sqRingSize = cqRingSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+
+	uint8_t* sqRing = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ringFile, IORING_OFF_SQ_RING);
+	if (sqRing == MAP_FAILED)
+	{
+		close(ringFile);
+		return false;
+	}
+
+	uint8_t* cqRing = sqRing;
+	if (!isSingleMap)
+	{
+		cqRing = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, ringFile, IORING_OFF_CQ_RING);
+		if (cqRing == MAP_FAILED)
+		{
+			munmap(sqRing, sqRingSize);
+			close(ringFile);
+			return false;
+		}
+	}
+
+	size_t sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	struct io_uring_sqe* sqes = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, ringFile, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED)
+	{
+		if (!isSingleMap)
+			munmap(cqRing, cqRingSize);
+		munmap(sqRing, sqRingSize);
+		close(ringFile);
+		return false;
+	}
+
+	ring->sqRing = sqRing;
+	ring->cqRing = cqRing;
+	ring->sqes = sqes;
+	ring->cqes = (struct io_uring_cqe*)(cqRing + params.cq_off.cqes);
+	ring->sqHead = (uint32_t*)(sqRing + params.sq_off.head);
+	ring->sqTail = (uint32_t*)(sqRing + params.sq_off.tail);
+	ring->sqArray = (uint32_t*)(sqRing + params.sq_off.array);
+	ring->cqHead = (uint32_t*)(cqRing + params.cq_off.head);
+	ring->cqTail = (uint32_t*)(cqRing + params.cq_off.tail);
+	ring->sqRingSize = sqRingSize;
+	ring->cqRingSize = cqRingSize;
+	ring->sqesSize = sqesSize;
+	ring->sqMask = *(uint32_t*)(sqRing + params.sq_off.ring_mask);
+	ring->cqMask = *(uint32_t*)(cqRing + params.cq_off.ring_mask);
+	ring->sqEntryCount = params.sq_entries;
+	ring->ringFile = ringFile;
+	return true;
+}
+/**
+ * @brief Destroys io_uring instance.
+ * @param[in] ring pointer to the ring structure
+ */
+inline static void destroyPackUring(PackUring* ring)
+{
+	munmap(ring->sqes, ring->sqesSize);
+	if (ring->cqRing != ring->sqRing)
+		munmap(ring->cqRing, ring->cqRingSize);
+	munmap(ring->sqRing, ring->sqRingSize);
+	close(ring->ringFile);
+}
+
+/**
+ * @brief Queues a new positional file read request.
+ * @return True on success, or false if submission queue is full.
+ *
+ * @param[in] ring pointer to the ring structure
+ * @param file target file descriptor
+ * @param offset file offset in bytes
+ * @param[out] buffer target read buffer
+ * @param size read size in bytes
+ * @param userData completion user data
+ */
+inline static bool queuePackUringRead(PackUring* ring, int file,
+	uint64_t offset, void* buffer, uint32_t size, uint64_t userData)
+{
+	uint32_t tail = *ring->sqTail;
+	uint32_t head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+	if (tail - head >= ring->sqEntryCount)
+		return false;
+
+	uint32_t index = tail & ring->sqMask;
+	struct io_uring_sqe* sqe = &ring->sqes[index];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = file;
+	sqe->off = offset;
+	sqe->addr = (uint64_t)(uintptr_t)buffer;
+	sqe->len = size;
+	sqe->user_data = userData;
+
+	ring->sqArray[index] = index;
+	__atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+	ring->unsubmittedCount++;
+	return true;
+}
+/**
+ * @brief Submits queued requests and optionally waits for the completions.
+ * @return True on success, otherwise false.
+ *
+ * @param[in] ring pointer to the ring structure
+ * @param waitCount minimal completion count to wait for
+ */
+inline static bool submitPackUring(PackUring* ring, uint32_t waitCount)
+{
+	while (true)
+	{
+		int result = (int)syscall(__NR_io_uring_enter, ring->ringFile, ring->unsubmittedCount,
+			waitCount, waitCount > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+		if (result >= 0)
+		{
+			ring->unsubmittedCount -= (uint32_t)result;
+			return true;
+		}
+		if (errno != EINTR)
+			return false;
+	}
+}
+
+/**
+ * @brief Returns next ready completion, or NULL if there are no completions.
+ * @param[in] ring pointer to the ring structure
+ */
+inline static struct io_uring_cqe* peekPackUring(PackUring* ring)
+{
+	uint32_t head = *ring->cqHead;
+	if (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE))
+		return NULL;
+	return &ring->cqes[head & ring->cqMask];
+}
+/**
+ * @brief Marks the peeked completion as consumed.
+ * @param[in] ring pointer to the ring structure
+ */
+inline static void advancePackUring(PackUring* ring)
+{
+	__atomic_store_n(ring->cqHead, *ring->cqHead + 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,172 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pack/overlay.h"
+
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+typedef struct PackOverlaySlot
+{
+	uint32_t pathHash;
+	uint32_t itemIndex; // NOTE: Item index + 1, or 0 if slot is empty.
+	uint32_t packIndex;
+} PackOverlaySlot;
+
+struct PackOverlay_T
+{
+	PackReader* packReaders;
+	PackOverlaySlot* hashSlots;
+	uint64_t hashSlotCount;
+	uint64_t itemCount;
+	uint32_t packCount;
+};
+
+/**********************************************************************************************************************/
+static PackOverlaySlot* findPackOverlaySlot(PackOverlaySlot* hashSlots, uint64_t hashSlotCount,
+	const PackReader* packReaders, const char* path, uint64_t pathHash)
+{
+	uint32_t slotHash = (uint32_t)(pathHash >> 32);
+	uint64_t slotMask = hashSlotCount - 1;
+	uint64_t slotIndex = pathHash & slotMask;
+
+	while (true)
+	{
+		PackOverlaySlot* hashSlot = &hashSlots[slotIndex];
+		if (hashSlot->itemIndex == 0)
+			return hashSlot;
+
+		if (hashSlot->pathHash == slotHash && strcmp(getPackItemPath(
+			packReaders[hashSlot->packIndex], hashSlot->itemIndex - 1), path) == 0)
+		{
+			return hashSlot;
+		}
+
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+}
+
+PackResult createPackOverlay(const PackReader* packReaders, uint32_t packCount, PackOverlay* packOverlay)
+{
+	assert(packReaders != NULL);
+	assert(packCount > 0);
+	assert(packOverlay != NULL);
+
+	uint64_t totalItemCount = 0;
+	for (uint32_t i = 0; i < packCount; i++)
+	{
+		assert(packReaders[i] != NULL);
+		totalItemCount += getPackItemCount(packReaders[i]);
+	}
+
+	if (totalItemCount > UINT32_MAX)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	PackOverlay overlayInstance = calloc(1, sizeof(PackOverlay_T));
+	if (!overlayInstance)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	// NOTE: Slot count is based on the total item count, so it fits all paths even if none of them are overridden.
+	uint64_t hashSlotCount = getPackHashSlotCount(totalItemCount);
+	PackReader* readers = malloc(packCount * sizeof(PackReader));
+	PackOverlaySlot* hashSlots = calloc(hashSlotCount, sizeof(PackOverlaySlot));
+
+	if (!readers || !hashSlots)
+	{
+		free(hashSlots); free(readers);
+		free(overlayInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	memcpy(readers, packReaders, packCount * sizeof(PackReader));
+
+	uint64_t itemCount = 0;
+	for (int64_t packIndex = (int64_t)packCount - 1; packIndex >= 0; packIndex--)
+	{
+		// NOTE: Packs are merged from the top, so the already added paths always have higher priority.
+		PackReader packReader = readers[packIndex];
+		uint64_t packItemCount = getPackItemCount(packReader);
+
+		for (uint64_t i = 0; i < packItemCount; i++)
+		{
+			const char* path = getPackItemPath(packReader, i);
+			uint64_t pathHash = hashPackItemPath(path, (uint8_t)strlen(path));
+
+			PackOverlaySlot* hashSlot = findPackOverlaySlot(hashSlots, hashSlotCount, readers, path, pathHash);
+			if (hashSlot->itemIndex != 0)
+				continue;
+
+			hashSlot->pathHash = (uint32_t)(pathHash >> 32);
+			hashSlot->itemIndex = (uint32_t)(i + 1);
+			hashSlot->packIndex = (uint32_t)packIndex;
+			itemCount++;
+		}
+	}
+
+	overlayInstance->packReaders = readers;
+	overlayInstance->hashSlots = hashSlots;
+	overlayInstance->hashSlotCount = hashSlotCount;
+	overlayInstance->itemCount = itemCount;
+	overlayInstance->packCount = packCount;
+
+	*packOverlay = overlayInstance;
+	return SUCCESS_PACK_RESULT;
+}
+void destroyPackOverlay(PackOverlay packOverlay)
+{
+	if (!packOverlay)
+		return;
+
+	free(packOverlay->hashSlots);
+	free(packOverlay->packReaders);
+	free(packOverlay);
+}
+
+/**********************************************************************************************************************/
+bool getPackOverlayItem(PackOverlay packOverlay, const char* path, PackOverlayItem* item)
+{
+	assert(packOverlay != NULL);
+	assert(path != NULL);
+	assert(item != NULL);
+	assert(strlen(path) <= UINT8_MAX);
+
+	uint64_t pathHash = hashPackItemPath(path, (uint8_t)strlen(path));
+	const PackOverlaySlot* hashSlot = findPackOverlaySlot(packOverlay->hashSlots,
+		packOverlay->hashSlotCount, packOverlay->packReaders, path, pathHash);
+	if (hashSlot->itemIndex == 0)
+		return false;
+
+	item->packReader = packOverlay->packReaders[hashSlot->packIndex];
+	item->itemIndex = hashSlot->itemIndex - 1;
+	item->packIndex = hashSlot->packIndex;
+	return true;
+}
+
+uint64_t getPackOverlayItemCount(PackOverlay packOverlay)
+{
+	assert(packOverlay != NULL);
+	return packOverlay->itemCount;
+}
+uint32_t getPackOverlayPackCount(PackOverlay packOverlay)
+{
+	assert(packOverlay != NULL);
+	return packOverlay->packCount;
+}
+PackReader getPackOverlayReader(PackOverlay packOverlay, uint32_t packIndex)
+{
+	assert(packOverlay != NULL);
+	assert(packIndex < packOverlay->packCount);
+	return packOverlay->packReaders[packIndex];
+}
@@ -14,137 +14,379 @@
 
 #include "pack/reader.h"
 #include "mpio/file.h"
+#include "atomic.h"
+#include "thread.h"
+
+#if PACK_IO_URING
+#include "io_uring.h"
+#endif
 
 #if __APPLE__
 #include "mpio/directory.h"
 #endif
 
 #include "zstd.h"
-#include "lz4.h"
+#define LZ4F_STATIC_LINKING_ONLY
+#include "lz4frame.h"
 
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
 
-typedef struct PackItem
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef HANDLE PackFile;
+#define NULL_PACK_FILE INVALID_HANDLE_VALUE
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#if __linux__
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+typedef int PackFile;
+#define NULL_PACK_FILE -1
+#endif
+
+#define MAX_BATCH_GAP_SIZE 16384
+#define MAX_BATCH_READ_SIZE 4194304
+#define MAX_CACHE_SHARD_COUNT 64
+#define MIN_READ_COUNTER_COUNT 8
+#define BLOCK_CACHE_SIZE 8
+#define STREAM_CHUNK_SIZE 131072
+
+typedef struct PackBatchItem
+{
+	uint64_t dataOffset;
+	uint64_t batchIndex;
+} PackBatchItem;
+
+typedef struct PackZipContext
 {
+	ZSTD_DCtx* zstdContext;
+	LZ4F_dctx* lz4Context;
+	uint8_t* blockData;
+} PackZipContext;
+
+typedef struct PackReadContext
+{
+	PackZipContext* zipContext;
+	uint8_t* zipBuffer;
+	size_t zipBufferSize;
+	uint8_t* frameBuffer;
+	volatile int32_t isBusy;
+	uint8_t _padding[64 - sizeof(void*) * 4 - sizeof(int32_t)]; // NOTE: Prevents false sharing.
+} PackReadContext;
+
+struct PackItemStream_T
+{
+	PackReader packReader;
+	PackZipContext* zipContext;
+	uint8_t* zipBuffer;
+	const uint8_t* zipInput;
+	size_t zipInputSize;
+	size_t zipInputOffset;
 	PackItemHeader header;
-	char* path;
-} PackItem;
+	uint32_t zipOffset;
+	uint32_t dataOffset;
+	uint32_t itemChecksum;
+	uint32_t checksum;
+	bool verifyChecksum;
+};
+
+typedef struct PackReadRequest
+{
+	uint8_t* buffer;
+	void* argument;
+	uint8_t* zipBuffer;
+	size_t zipBufferSize;
+	uint64_t itemIndex;
+	uint32_t readSize;
+} PackReadRequest;
+
+struct PackReadQueue_T
+{
+	PackReader packReader;
+	PackReadRequest* requests;
+	uint32_t* freeRequests;
+	OnPackItemRead onItemRead;
+	PackZipContext* zipContext;
+	uint32_t queueDepth;
+	uint32_t freeCount;
+	uint32_t pendingCount;
+	bool isAsync;
+	#if PACK_IO_URING
+	PackUring ring;
+	#endif
+};
+
+typedef struct PackCacheEntry
+{
+	uint64_t itemIndex;
+	uint32_t dataSize;
+	volatile int32_t refCount;
+	bool isReferenced;
+} PackCacheEntry; // NOTE: Item data is stored right after the entry.
+
+typedef struct PackCacheShard
+{
+	PackCacheEntry** clockEntries;
+	uint64_t clockCount;
+	uint64_t clockCapacity;
+	uint64_t clockHand;
+	uint64_t cachedSize;
+	uint64_t hitCount;
+	uint64_t missCount;
+	uint64_t evictionCount;
+	volatile int32_t isLocked;
+	uint8_t _padding[128 - sizeof(void*) - sizeof(uint64_t) * 7 - sizeof(int32_t)]; // NOTE: Prevents false sharing.
+} PackCacheShard;
+
+typedef struct PackItemCache
+{
+	PackCacheEntry** entries;
+	PackCacheShard* shards;
+	uint64_t capacity;
+	uint64_t shardCapacity;
+	uint32_t shardCount;
+} PackItemCache;
+
+typedef struct PackBlockEntry
+{
+	uint8_t* data;
+	uint64_t dataOffset;
+	uint64_t useIndex;
+	uint32_t dataSize;
+} PackBlockEntry;
+
+typedef struct PackBlockCache
+{
+	PackBlockEntry entries[BLOCK_CACHE_SIZE];
+	uint64_t useCounter;
+	volatile int32_t isLocked;
+} PackBlockCache;
+
+typedef struct PackReadCounters
+{
+	volatile int64_t itemReadCount;
+	volatile int64_t zipReadSize;
+	volatile int64_t rawReadSize;
+	volatile int64_t readTime;
+	volatile int64_t zipTime;
+	volatile int64_t zipBufferSize;
+	volatile int64_t lookupCount;
+	volatile int64_t lookupMissCount;
+} PackReadCounters; // NOTE: Fits the 64 byte cache line, prevents false sharing.
+
+typedef struct PackUnpackData
+{
+	PackReader packReader;
+	bool* createdFiles;
+	uint64_t unpackedCount;
+	uint64_t damagedCount;
+	uint64_t rawFileSize;
+	uint64_t fileOffset;
+	volatile int64_t itemIndex;
+	PackMutex mutex;
+	PackResult packResult;
+	volatile int32_t isAborted;
+	bool printProgress;
+	bool isVerifying;
+} PackUnpackData;
+
+typedef struct PackUnpacker
+{
+	PackUnpackData* unpackData;
+	uint8_t* data;
+	uint32_t dataSize;
+	uint32_t threadIndex;
+} PackUnpacker;
+
 struct PackReader_T
 {
 	uint8_t** zipBuffers;
 	size_t* zipBufferSizes;
-	void** zipContexts;
-	FILE** files;
+	PackZipContext** zipContexts;
+	void** zstdContexts;
+	PackReadContext* readContexts;
+	PackItemCache* itemCache;
+	PackBlockCache* blockCache;
+	PackReadCounters* readCounters;
+	ZSTD_DDict* zstdDictionary;
+	const uint8_t* dictionary;
+	uint8_t* dictionaryData;
+	const uint8_t* mappedData;
+	uint64_t mappedSize;
+	bool isMemoryData;
 	uint64_t itemCount;
-	PackItem* items;
+	PackItemHeader* itemHeaders;
+	PackHashSlot* hashSlots;
+	uint64_t* pathOffsets;
+	uint32_t* itemChecksums;
+	char* paths;
+	uint64_t hashSlotCount;
+	volatile int64_t readContextIndex;
+	PackFile file;
 	uint32_t threadCount;
+	uint32_t readCounterMask;
+	uint32_t dictionarySize;
+	PackAccess access;
+	bool verifyChecksums;
 	bool preferSpeed;
+	bool hasZstdItems;
+	bool hasLz4Items;
+	bool hasSolidItems;
 };
 
-static void destroyPackItems(uint64_t itemCount, PackItem* items)
-{
-	assert(itemCount == 0 || (itemCount > 0 && items != NULL));
-	for (uint64_t i = 0; i < itemCount; i++) free(items[i].path);
-	free(items);
-}
-static PackResult createPackItems(FILE* packFile,
-	uint64_t itemCount, PackItem** _items)
+static PackResult createPackItems(PackReader packReader, const uint8_t* indexData,
+	uint64_t indexSize, uint64_t itemCount, bool hasChecksums, uint64_t fileSize)
 {
-	assert(packFile != NULL);
-	assert(itemCount > 0);
-	assert(_items != NULL);
+	assert(packReader != NULL);
+	assert(indexData != NULL);
+
+	// NOTE: Item count comes from the file header, so it is checked before sizing the hash table.
+	if (itemCount == 0 || itemCount >= UINT32_MAX)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	uint64_t hashSlotCount = getPackHashSlotCount(itemCount);
+	uint64_t itemSize = sizeof(PackItemHeader) + (hasChecksums ? sizeof(uint32_t) : 0);
+	if (indexSize / sizeof(PackHashSlot) < hashSlotCount ||
+		itemCount > (indexSize - hashSlotCount * sizeof(PackHashSlot)) / itemSize)
+	{
+		return BAD_DATA_SIZE_PACK_RESULT;
+	}
+
+	uint64_t headersSize = itemCount * sizeof(PackItemHeader);
+	uint64_t hashSlotsSize = hashSlotCount * sizeof(PackHashSlot);
+	uint64_t checksumsSize = hasChecksums ? itemCount * sizeof(uint32_t) : 0;
+	uint64_t pathDataSize = indexSize - (headersSize + hashSlotsSize + checksumsSize);
+	uint64_t pathOffsetsSize = itemCount * sizeof(uint64_t);
+	uint64_t pathArenaSize = pathDataSize + itemCount; // NOTE: paths are stored null-terminated.
+	uint64_t itemDataSize = headersSize + hashSlotsSize + pathOffsetsSize + checksumsSize + pathArenaSize;
+
+	if (itemDataSize > SIZE_MAX)
+		return BAD_DATA_SIZE_PACK_RESULT;
 
-	PackItem* items = malloc(itemCount * sizeof(PackItem));
-	if (!items)
+	// NOTE: item headers, hash slots, path offsets, checksums and path strings are stored in one memory block.
+	uint8_t* itemData = malloc((size_t)itemDataSize);
+	if (!itemData)
 		return FAILED_TO_ALLOCATE_PACK_RESULT;
 
+	PackItemHeader* itemHeaders = (PackItemHeader*)itemData;
+	PackHashSlot* hashSlots = (PackHashSlot*)(itemData + headersSize);
+	uint64_t* pathOffsets = (uint64_t*)(itemData + headersSize + hashSlotsSize);
+	uint32_t* itemChecksums = (uint32_t*)(itemData + headersSize + hashSlotsSize + pathOffsetsSize);
+	char* paths = (char*)(itemData + headersSize + hashSlotsSize + pathOffsetsSize + checksumsSize);
+	memcpy(itemData, indexData, (size_t)(headersSize + hashSlotsSize));
+	memcpy(itemChecksums, indexData + headersSize + hashSlotsSize, (size_t)checksumsSize);
+
+	const uint8_t* pathData = indexData + headersSize + hashSlotsSize + checksumsSize;
+	uint64_t pathOffset = 0;
+
 	for (uint64_t i = 0; i < itemCount; i++)
 	{
-		PackItemHeader header;
-		if (fread(&header, sizeof(PackItemHeader), 1, packFile) != 1)
+		PackItemHeader header = itemHeaders[i];
+		if (header.dataSize == 0 || header.pathSize == 0 || header.dataOffset == 0 ||
+			pathOffset + header.pathSize > pathDataSize)
 		{
-			destroyPackItems(i, items);
-			return FAILED_TO_READ_FILE_PACK_RESULT;
+			free(itemData);
+			return BAD_DATA_SIZE_PACK_RESULT;
 		}
 
-		if (header.dataSize == 0 || header.pathSize == 0 || header.dataOffset == 0)
+		if (header.isSolid)
 		{
-			destroyPackItems(i, items);
-			return BAD_DATA_SIZE_PACK_RESULT;
+			if (header.dataOffset + sizeof(PackBlockHeader) > fileSize || 
+				(uint64_t)header.zipSize + header.dataSize > PACK_BLOCK_SIZE)
+			{
+				free(itemData);
+				return BAD_DATA_SIZE_PACK_RESULT;
+			}
+			packReader->hasSolidItems = true;
 		}
-
-		char* path = malloc(header.pathSize + 1);
-		if (!path)
+		else
 		{
-			destroyPackItems(i, items);
-			return FAILED_TO_ALLOCATE_PACK_RESULT;
+			uint32_t zipItemSize = header.zipSize > 0 ? header.zipSize : header.dataSize;
+			if (header.dataOffset + zipItemSize > fileSize)
+			{
+				free(itemData);
+				return BAD_DATA_SIZE_PACK_RESULT;
+			}
 		}
 
-		if (fread(path, sizeof(char), header.pathSize, packFile) != header.pathSize)
+		if (header.zipSize > 0 || header.isSolid)
 		{
-			destroyPackItems(i, items);
-			return FAILED_TO_READ_FILE_PACK_RESULT;
+			if (header.preferSpeed)
+				packReader->hasLz4Items = true;
+			else packReader->hasZstdItems = true;
 		}
 
-		path[header.pathSize] = 0;
+		char* path = paths + pathOffset + i;
+		memcpy(path, pathData + pathOffset, header.pathSize);
+		path[header.pathSize] = '\0';
+		pathOffsets[i] = pathOffset + i;
+		pathOffset += header.pathSize;
+	}
 
-		if (!header.isReference)
-		{
-			int64_t fileOffset = header.zipSize > 0 ? header.zipSize : header.dataSize;
-			int seekResult = seekFile(packFile, fileOffset, SEEK_CUR);
+	if (pathOffset != pathDataSize)
+	{
+		free(itemData);
+		return BAD_DATA_SIZE_PACK_RESULT;
+	}
 
-			if (seekResult != 0)
-			{
-				destroyPackItems(i, items);
-				return FAILED_TO_SEEK_FILE_PACK_RESULT;
-			}
+	bool hasEmptySlot = false;
+	for (uint64_t i = 0; i < hashSlotCount; i++)
+	{
+		uint32_t itemIndex = hashSlots[i].itemIndex;
+		if (itemIndex > itemCount)
+		{
+			free(itemData);
+			return BAD_DATA_SIZE_PACK_RESULT;
 		}
+		hasEmptySlot |= itemIndex == 0;
+	}
 
-		PackItem item;
-		item.header = header;
-		item.path = path;
-		items[i] = item;
+	if (!hasEmptySlot) // NOTE: lookup relies on the empty slot to stop probing.
+	{
+		free(itemData);
+		return BAD_DATA_SIZE_PACK_RESULT;
 	}
 
-	*_items = items;
+	packReader->itemCount = itemCount;
+	packReader->itemHeaders = itemHeaders;
+	packReader->hashSlots = hashSlots;
+	packReader->pathOffsets = pathOffsets;
+	packReader->itemChecksums = hasChecksums ? itemChecksums : NULL;
+	packReader->paths = paths;
+	packReader->hashSlotCount = hashSlotCount;
 	return SUCCESS_PACK_RESULT;
 }
 
 /**********************************************************************************************************************/
-PackResult createFilePackReader(const char* filePath, uint32_t dataVersion,
-	bool isResourcesDirectory, uint32_t threadCount, PackReader* packReader)
+static PackResult createPackFilePath(const char* filePath, bool isResourcesDirectory, char** _path)
 {
 	assert(filePath != NULL);
-	assert(threadCount > 0);
-	assert(packReader != NULL);
-
-	PackReader packReaderInstance = calloc(1, sizeof(PackReader_T));
-	if (!packReaderInstance)
-		return FAILED_TO_ALLOCATE_PACK_RESULT;
-	packReaderInstance->threadCount = threadCount;
-
-	char* path;
+	assert(_path != NULL);
 
 	#if __APPLE__
 	if (isResourcesDirectory)
 	{
 		char* resourcesDirectory = getResourcesDirectory();
 		if (!resourcesDirectory)
-		{
-			destroyPackReader(packReaderInstance);
 			return FAILED_TO_GET_DIRECTORY_PACK_RESULT;
-		}
 
 		size_t filePathLength = strlen(filePath);
 		size_t resourcesPathLength = strlen(resourcesDirectory);
 		size_t pathLength = filePathLength + resourcesPathLength + 2;
 
-		path = malloc(pathLength);
+		char* path = malloc(pathLength);
 		if (!path)
 		{
-			destroyPackReader(packReaderInstance);
+			free(resourcesDirectory);
 			return FAILED_TO_ALLOCATE_PACK_RESULT;
 		}
 
@@ -153,290 +395,2437 @@ PackResult createFilePackReader(const char* filePath, uint32_t dataVersion,
 		memcpy(path + resourcesPathLength + 1, filePath, filePathLength);
 		path[resourcesPathLength + filePathLength + 1] = '\0';
 		free(resourcesDirectory);
+
+		*_path = path;
+		return SUCCESS_PACK_RESULT;
 	}
-	else
-	{
-		path = (char*)filePath;
-	}
-	#else
-	path = (char*)filePath;
 	#endif
 
-	FILE** files = calloc(threadCount, sizeof(FILE*));
-	if (!files)
+	*_path = (char*)filePath;
+	return SUCCESS_PACK_RESULT;
+}
+static void destroyPackFilePath(const char* filePath, char* path)
+{
+	if (path != filePath)
+		free(path);
+}
+
+static PackResult checkPackHeader(const PackHeader* header, uint32_t dataVersion)
+{
+	assert(header != NULL);
+
+	if (header->magic != PACK_HEADER_MAGIC)
+		return BAD_FILE_TYPE_PACK_RESULT;
+	if (header->versionMajor != PACK_VERSION_MAJOR ||
+		header->versionMinor != PACK_VERSION_MINOR)
 	{
-		#if __APPLE__
-		if (isResourcesDirectory)
-			free(path);
-		#endif
-		destroyPackReader(packReaderInstance);
+		return BAD_FILE_VERSION_PACK_RESULT;
+	}
+	// Skipping PATCH version check
+
+	if (header->isBigEndian != !PACK_LITTLE_ENDIAN)
+		return BAD_FILE_ENDIANNESS_PACK_RESULT;
+	if (dataVersion != 0 && header->dataVersion != dataVersion)
+		return BAD_FILE_DATA_VERSION_PACK_RESULT;
+	return SUCCESS_PACK_RESULT;
+}
+
+static PackResult openPackFile(const char* path, PackFile* _file, uint64_t* _fileSize)
+{
+	assert(path != NULL);
+	assert(_file != NULL);
+	assert(_fileSize != NULL);
+
+	#if _WIN32
+	int pathLength = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+	if (pathLength <= 0)
+		return FAILED_TO_OPEN_FILE_PACK_RESULT;
+
+	wchar_t* widePath = malloc(pathLength * sizeof(wchar_t));
+	if (!widePath)
 		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	if (MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath, pathLength) != pathLength)
+	{
+		free(widePath);
+		return FAILED_TO_OPEN_FILE_PACK_RESULT;
 	}
-	packReaderInstance->files = files;
 
-	for (uint32_t i = 0; i < threadCount; i++)
+	HANDLE file = CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	free(widePath);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return FAILED_TO_OPEN_FILE_PACK_RESULT;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
 	{
-		FILE* file = openFile(path, "rb");
-		if (!file)
-		{
-			#if __APPLE__
-			if (isResourcesDirectory)
-				free(path);
-			#endif
-			destroyPackReader(packReaderInstance);
-			return FAILED_TO_OPEN_FILE_PACK_RESULT;
-		}
+		CloseHandle(file);
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+	*_fileSize = (uint64_t)fileSize.QuadPart;
+	#else
+	int file = open(path, O_RDONLY);
+	if (file == -1)
+		return FAILED_TO_OPEN_FILE_PACK_RESULT;
 
-		files[i] = file;
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+	{
+		close(file);
+		return FAILED_TO_READ_FILE_PACK_RESULT;
 	}
+	*_fileSize = (uint64_t)fileStat.st_size;
+	#endif
 
-	#if __APPLE__
-	if (isResourcesDirectory)
-		free(path);
+	*_file = file;
+	return SUCCESS_PACK_RESULT;
+}
+static void closePackFile(PackFile file)
+{
+	#if _WIN32
+	if (!CloseHandle(file)) abort();
+	#else
+	if (close(file) != 0) abort();
 	#endif
+}
 
-	PackHeader header;
-	FILE* file = files[0];
+// NOTE: Positional read does not use the shared file position, so it's safe to call concurrently.
+static bool readPackFile(PackFile file, uint64_t offset, void* buffer, size_t size)
+{
+	assert(buffer != NULL);
+	uint8_t* data = (uint8_t*)buffer;
 
-	if (fread(&header, sizeof(PackHeader), 1, file) != 1)
+	while (size > 0)
 	{
-		destroyPackReader(packReaderInstance);
-		return FAILED_TO_READ_FILE_PACK_RESULT;
+		size_t readSize = size > 0x40000000 ? 0x40000000 : size;
+
+		#if _WIN32
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(OVERLAPPED));
+		overlapped.Offset = (DWORD)offset;
+		overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+		DWORD result;
+		if (!ReadFile(file, data, (DWORD)readSize, &result, &overlapped) || result == 0)
+			return false;
+		#else
+		ssize_t result = pread(file, data, readSize, (off_t)offset);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			return false;
+		#endif
+
+		data += result;
+		offset += (uint64_t)result;
+		size -= (size_t)result;
 	}
 
-	if (header.magic != PACK_HEADER_MAGIC)
+	return true;
+}
+
+static PackResult mapPackFile(PackFile file, uint64_t fileSize, const uint8_t** _mappedData)
+{
+	assert(_mappedData != NULL);
+
+	if (fileSize > SIZE_MAX)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	#if _WIN32
+	HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping)
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+
+	void* mappedData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!mappedData)
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+	#else
+	void* mappedData = mmap(NULL, (size_t)fileSize, PROT_READ, MAP_SHARED, file, 0);
+	if (mappedData == MAP_FAILED)
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+	#endif
+
+	*_mappedData = (const uint8_t*)mappedData;
+	return SUCCESS_PACK_RESULT;
+}
+static void unmapPackFile(const uint8_t* mappedData, uint64_t mappedSize)
+{
+	assert(mappedData != NULL);
+
+	#if _WIN32
+	if (!UnmapViewOfFile(mappedData)) abort();
+	#else
+	if (munmap((void*)mappedData, (size_t)mappedSize) != 0) abort();
+	#endif
+}
+
+static void advisePackFileAccess(PackFile file, const uint8_t* mappedData, uint64_t mappedSize, PackAccess access)
+{
+	// NOTE: Access advice is only a hint, so errors are ignored.
+	#if !_WIN32
+	if (mappedData)
 	{
-		destroyPackReader(packReaderInstance);
-		return BAD_FILE_TYPE_PACK_RESULT;
+		int advice = access == RANDOM_PACK_ACCESS ? MADV_RANDOM :
+			access == SEQUENTIAL_PACK_ACCESS ? MADV_SEQUENTIAL : MADV_NORMAL;
+		madvise((void*)mappedData, (size_t)mappedSize, advice);
 	}
-	if (header.versionMajor != PACK_VERSION_MAJOR ||
-		header.versionMinor != PACK_VERSION_MINOR)
+	else
 	{
-		destroyPackReader(packReaderInstance);
-		return BAD_FILE_VERSION_PACK_RESULT;
+		#if __APPLE__
+		fcntl(file, F_RDAHEAD, access == RANDOM_PACK_ACCESS ? 0 : 1);
+		#else
+		int advice = access == RANDOM_PACK_ACCESS ? POSIX_FADV_RANDOM :
+			access == SEQUENTIAL_PACK_ACCESS ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL;
+		posix_fadvise(file, 0, 0, advice);
+		#endif
 	}
-	// Skipping PATCH version check
+	#endif
+}
+static void advisePackFileRange(PackFile file, const uint8_t* mappedData, uint64_t offset, uint64_t size)
+{
+	// NOTE: Prefetch advice is only a hint, so errors are ignored.
+	#if _WIN32
+	// NOTE: PrefetchVirtualMemory() is loaded at runtime, because it is missing on Windows 7.
+	typedef struct PrefetchRange
+	{
+		PVOID virtualAddress;
+		SIZE_T numberOfBytes;
+	} PrefetchRange;
+	typedef BOOL (WINAPI* PrefetchVirtualMemoryFunc)(HANDLE, ULONG_PTR, PrefetchRange*, ULONG);
+
+	(void)file;
+	if (!mappedData)
+		return;
 
-	if (header.isBigEndian != !PACK_LITTLE_ENDIAN)
+	HMODULE kernelModule = GetModuleHandleW(L"kernel32.dll");
+	if (!kernelModule)
+		return;
+	PrefetchVirtualMemoryFunc prefetchVirtualMemory = (PrefetchVirtualMemoryFunc)(void*)
+		GetProcAddress(kernelModule, "PrefetchVirtualMemory");
+	if (!prefetchVirtualMemory || size > SIZE_MAX)
+		return;
+
+	PrefetchRange range;
+	range.virtualAddress = (PVOID)(mappedData + offset);
+	range.numberOfBytes = (SIZE_T)size;
+	prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	#else
+	if (mappedData)
 	{
-		destroyPackReader(packReaderInstance);
-		return BAD_FILE_ENDIANNESS_PACK_RESULT;
+		// NOTE: madvise() requires a page aligned address.
+		uint64_t pageMask = (uint64_t)sysconf(_SC_PAGESIZE) - 1;
+		uint64_t alignedOffset = offset & ~pageMask;
+		madvise((void*)(mappedData + alignedOffset), (size_t)(offset + size - alignedOffset), MADV_WILLNEED);
 	}
-	if (dataVersion != 0 && header.dataVersion != dataVersion)
+	else
 	{
-		destroyPackReader(packReaderInstance);
-		return BAD_FILE_DATA_VERSION_PACK_RESULT;
+		#if __APPLE__
+		if (offset > INT64_MAX || size > INT32_MAX)
+			return;
+		struct radvisory advisory;
+		advisory.ra_offset = (off_t)offset;
+		advisory.ra_count = (int)size;
+		fcntl(file, F_RDADVISE, &advisory);
+		#else
+		posix_fadvise(file, (off_t)offset, (off_t)size, POSIX_FADV_WILLNEED);
+		#endif
 	}
+	#endif
+}
 
-	packReaderInstance->preferSpeed = header.preferSpeed ? true : false;
+/**********************************************************************************************************************/
+static void destroyPackZipContext(PackZipContext* zipContext)
+{
+	if (!zipContext)
+		return;
+
+	if (zipContext->lz4Context && LZ4F_isError(LZ4F_freeDecompressionContext(zipContext->lz4Context)))
+		abort();
+	if (ZSTD_freeDCtx(zipContext->zstdContext) != 0)
+		abort();
+	free(zipContext->blockData);
+	free(zipContext);
+}
+static PackZipContext* createPackZipContext(PackReader packReader)
+{
+	assert(packReader != NULL);
 
-	if (!header.preferSpeed)
+	PackZipContext* zipContext = calloc(1, sizeof(PackZipContext));
+	if (!zipContext)
+		return NULL;
+
+	// NOTE: Only decompression contexts of the item algorithms used by this pack are created.
+	if (packReader->hasLz4Items || packReader->preferSpeed)
 	{
-		void** zipContexts = calloc(threadCount, sizeof(void*));
-		if (!zipContexts)
+		LZ4F_dctx* lz4Context;
+		if (LZ4F_isError(LZ4F_createDecompressionContext(&lz4Context, LZ4F_VERSION)))
 		{
-			destroyPackReader(packReaderInstance);
-			return FAILED_TO_ALLOCATE_PACK_RESULT;
+			destroyPackZipContext(zipContext);
+			return NULL;
+		}
+		zipContext->lz4Context = lz4Context;
+	}
+	if (packReader->hasZstdItems || !packReader->preferSpeed)
+	{
+		ZSTD_DCtx* zstdContext = ZSTD_createDCtx();
+		if (!zstdContext)
+		{
+			destroyPackZipContext(zipContext);
+			return NULL;
 		}
-		packReaderInstance->zipContexts = zipContexts;
+		zipContext->zstdContext = zstdContext;
 
-		for (uint32_t i = 0; i < threadCount; i++)
+		if (packReader->zstdDictionary)
 		{
-			ZSTD_DCtx* zstdContext = ZSTD_createDCtx();
-			if (!zstdContext)
+			// NOTE: Shared dictionary is only referenced, so each context doesn't load it again.
+			if (ZSTD_isError(ZSTD_DCtx_refDDict(zstdContext, packReader->zstdDictionary)))
 			{
-				destroyPackReader(packReaderInstance);
-				return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+				destroyPackZipContext(zipContext);
+				return NULL;
 			}
-			zipContexts[i] = zstdContext;
 		}
 	}
+	return zipContext;
+}
 
-	uint8_t** zipBuffers = calloc(threadCount, sizeof(uint8_t*));
-	if (!zipBuffers)
+static PackResult createPackDictionary(PackReader packReader, const uint8_t* dictionary, uint32_t dictionarySize)
+{
+	assert(packReader != NULL);
+	assert(dictionary != NULL);
+
+	if (dictionarySize == 0)
+		return SUCCESS_PACK_RESULT;
+
+	if (packReader->hasLz4Items)
 	{
-		destroyPackReader(packReaderInstance);
+		// NOTE: LZ4 uses dictionary in place, so it should stay valid until the reader is destroyed.
+		if (!packReader->mappedData)
+		{
+			uint8_t* dictionaryData = malloc(dictionarySize);
+			if (!dictionaryData)
+				return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+			memcpy(dictionaryData, dictionary, dictionarySize);
+			packReader->dictionaryData = dictionaryData;
+			dictionary = dictionaryData;
+		}
+
+		packReader->dictionary = dictionary;
+		packReader->dictionarySize = dictionarySize;
+	}
+	if (!packReader->hasZstdItems)
+		return SUCCESS_PACK_RESULT;
+
+	ZSTD_DDict* zstdDictionary = ZSTD_createDDict(dictionary, dictionarySize);
+	if (!zstdDictionary)
+		return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+
+	packReader->zstdDictionary = zstdDictionary;
+	packReader->dictionarySize = dictionarySize;
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult createPackZipContexts(PackReader packReader)
+{
+	assert(packReader != NULL);
+
+	if (packReader->hasSolidItems)
+	{
+		// NOTE: Decompressed solid blocks are shared between all reader threads.
+		packReader->blockCache = calloc(1, sizeof(PackBlockCache));
+		if (!packReader->blockCache)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	uint32_t threadCount = packReader->threadCount;
+	PackZipContext** zipContexts = calloc(threadCount, sizeof(PackZipContext*));
+	if (!zipContexts)
 		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	packReader->zipContexts = zipContexts;
+
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		PackZipContext* zipContext = createPackZipContext(packReader);
+		if (!zipContext)
+			return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+		zipContexts[i] = zipContext;
 	}
-	packReaderInstance->zipBuffers = zipBuffers;
+
+	if (!zipContexts[0]->zstdContext)
+		return SUCCESS_PACK_RESULT;
+
+	void** zstdContexts = malloc(threadCount * sizeof(void*));
+	if (!zstdContexts)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	packReader->zstdContexts = zstdContexts;
+
+	for (uint32_t i = 0; i < threadCount; i++)
+		zstdContexts[i] = zipContexts[i]->zstdContext;
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult createPackZipBuffers(PackReader packReader)
+{
+	assert(packReader != NULL);
+
+	uint32_t threadCount = packReader->threadCount;
+	uint8_t** zipBuffers = calloc(threadCount, sizeof(uint8_t*));
+	if (!zipBuffers)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	packReader->zipBuffers = zipBuffers;
 
 	size_t* zipBufferSizes = malloc(threadCount * sizeof(size_t));
 	if (!zipBufferSizes)
-	{
-		destroyPackReader(packReaderInstance);
 		return FAILED_TO_ALLOCATE_PACK_RESULT;
-	}
-	packReaderInstance->zipBufferSizes = zipBufferSizes;
+	packReader->zipBufferSizes = zipBufferSizes;
 
 	for (uint32_t i = 0; i < threadCount; i++)
 	{
 		uint8_t* zipBuffer = malloc(16);
 		if (!zipBuffer)
-		{
-			destroyPackReader(packReaderInstance);
 			return FAILED_TO_ALLOCATE_PACK_RESULT;
-		}
 
 		zipBuffers[i] = zipBuffer;
 		zipBufferSizes[i] = 16;
 	}
 
-	PackItem* items;
-	PackResult packResult = createPackItems(file, header.itemCount, &items);
-	if (packResult != SUCCESS_PACK_RESULT)
-	{
-		destroyPackReader(packReaderInstance);;
-		return packResult;
-	}
-
-	packReaderInstance->itemCount = header.itemCount;
-	packReaderInstance->items = items;
-
-	*packReader = packReaderInstance;
 	return SUCCESS_PACK_RESULT;
 }
-void destroyPackReader(PackReader packReader)
+
+static void destroyPackReadContext(PackReadContext* readContext)
 {
-	if (!packReader)
-		return;
+	assert(readContext != NULL);
+	destroyPackZipContext(readContext->zipContext);
+	free(readContext->frameBuffer);
+	free(readContext->zipBuffer);
+}
+static PackReadContext* acquirePackReadContext(PackReader packReader)
+{
+	assert(packReader != NULL);
 
-	destroyPackItems(packReader->itemCount, packReader->items);
+	PackReadContext* readContexts = packReader->readContexts;
+	uint32_t contextCount = packReader->threadCount;
+	uint32_t contextIndex = (uint32_t)((uint64_t)atomicFetchAdd64(
+		&packReader->readContextIndex, 1) % contextCount);
 
-	uint32_t threadCount = packReader->threadCount;
-	if (packReader->files)
+	for (uint32_t i = 0; i < contextCount; i++)
 	{
-		FILE** files = packReader->files;
-		for (uint32_t i = 0; i < threadCount; i++)
-		{
-			if (files[i])
-				closeFile(files[i]);
-		}
-		free(files);
+		PackReadContext* readContext = &readContexts[contextIndex];
+		if (atomicLoad32(&readContext->isBusy) == 0 && atomicCompareExchange32(&readContext->isBusy, 0, 1))
+			return readContext;
+		contextIndex = contextIndex + 1 < contextCount ? contextIndex + 1 : 0;
 	}
-	if (packReader->zipContexts && !packReader->preferSpeed)
+
+	return NULL; // NOTE: All pooled contexts are busy.
+}
+inline static void releasePackReadContext(PackReadContext* readContext)
+{
+	assert(readContext != NULL);
+	atomicStore32(&readContext->isBusy, 0);
+}
+
+static PackResult beginPackReadContext(PackReader packReader, 
+	PackReadContext* temporaryContext, PackReadContext** _readContext)
+{
+	assert(packReader != NULL);
+	assert(temporaryContext != NULL);
+	assert(_readContext != NULL);
+
+	PackReadContext* readContext = acquirePackReadContext(packReader);
+	if (!readContext)
 	{
-		ZSTD_DCtx** zipContexts = (ZSTD_DCtx**)packReader->zipContexts;
-		for (uint32_t i = 0; i < threadCount; i++)
-			if (ZSTD_freeDCtx(zipContexts[i]) != 0) abort();
-		free(zipContexts);
+		memset(temporaryContext, 0, sizeof(PackReadContext));
+		readContext = temporaryContext;
 	}
-	if (packReader->zipBuffers)
+
+	if (!readContext->zipContext)
 	{
-		uint8_t** zipBuffers = packReader->zipBuffers;
-		for (uint32_t i = 0; i < threadCount; i++)
-			free(zipBuffers[i]);
-		free(zipBuffers);
+		readContext->zipContext = createPackZipContext(packReader);
+		if (!readContext->zipContext)
+		{
+			if (readContext != temporaryContext)
+				releasePackReadContext(readContext);
+			return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+		}
 	}
-	free(packReader);
+
+	*_readContext = readContext;
+	return SUCCESS_PACK_RESULT;
+}
+static void endPackReadContext(PackReader packReader, 
+	PackReadContext* temporaryContext, PackReadContext* readContext)
+{
+	assert(packReader != NULL);
+	assert(readContext != NULL);
+
+	if (readContext == temporaryContext)
+		destroyPackReadContext(readContext);
+	else releasePackReadContext(readContext);
 }
 
 /**********************************************************************************************************************/
-uint64_t getPackItemCount(PackReader packReader)
+inline static uint64_t getPackTime()
+{
+	#if _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+	#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+	#endif
+}
+
+inline static PackReadCounters* getThreadReadCounters(PackReader packReader, uint32_t threadIndex)
 {
 	assert(packReader != NULL);
-	return packReader->itemCount;
+	return &packReader->readCounters[threadIndex & packReader->readCounterMask];
 }
+static volatile int32_t readCounterThreadCount = 0;
+static PACK_THREAD_LOCAL uint32_t readCounterSlot = UINT32_MAX;
 
-static int comparePackItems(const void* _a, const void* _b)
+// NOTE: Each thread gets its own counter slot once, so calls without a thread index don't share counters.
+static PackReadCounters* getLocalReadCounters(PackReader packReader)
 {
-	// NOTE: a and b should not be NULL!
-	// Skipping here assertions for debug build speed.
+	assert(packReader != NULL);
+	uint32_t counterSlot = readCounterSlot;
+	if (counterSlot == UINT32_MAX)
+		readCounterSlot = counterSlot = (uint32_t)atomicFetchAdd32(&readCounterThreadCount, 1) & INT32_MAX;
+	return &packReader->readCounters[counterSlot & packReader->readCounterMask];
+}
+
+inline static void addReadCounter(volatile int64_t* counter, uint64_t value)
+{
+	atomicFetchAdd64(counter, (int64_t)value);
+}
+static void countZipBufferSize(PackReadCounters* counters, size_t bufferSize)
+{
+	assert(counters != NULL);
+	int64_t zipBufferSize = atomicLoad64(&counters->zipBufferSize);
+	while (zipBufferSize < (int64_t)bufferSize && 
+		!atomicCompareExchange64(&counters->zipBufferSize, zipBufferSize, (int64_t)bufferSize))
+	{
+		zipBufferSize = atomicLoad64(&counters->zipBufferSize);
+	}
+}
 
-	const PackItem* a = _a;
-	const PackItem* b = _b;
-	int difference = (int)a->header.pathSize - (int)b->header.pathSize;
-	if (difference != 0)
-		return difference;
-	return memcmp(a->path, b->path, a->header.pathSize);
+/**********************************************************************************************************************/
+inline static void lockPackCacheShard(PackCacheShard* cacheShard)
+{
+	assert(cacheShard != NULL);
+	while (!atomicCompareExchange32(&cacheShard->isLocked, 0, 1))
+	{
+		while (atomicLoad32(&cacheShard->isLocked) != 0) { } // NOTE: Spinning on load to not bounce the cache line.
+	}
 }
-bool getPackItemIndex(PackReader packReader, const char* path, uint64_t* index)
+inline static void unlockPackCacheShard(PackCacheShard* cacheShard)
 {
-	assert(packReader != NULL);
-	assert(path != NULL);
-	assert(index != NULL);
-	assert(strlen(path) <= UINT8_MAX);
+	assert(cacheShard != NULL);
+	atomicStore32(&cacheShard->isLocked, 0);
+}
+inline static void releasePackCacheEntry(PackCacheEntry* cacheEntry)
+{
+	assert(cacheEntry != NULL);
+	if (atomicFetchAdd32(&cacheEntry->refCount, -1) == 1)
+		free(cacheEntry);
+}
+inline static PackCacheShard* getPackCacheShard(PackItemCache* itemCache, uint64_t itemIndex)
+{
+	assert(itemCache != NULL);
+	return &itemCache->shards[itemIndex & (itemCache->shardCount - 1)];
+}
+
+static void evictPackCacheEntry(PackItemCache* itemCache, PackCacheShard* cacheShard)
+{
+	assert(itemCache != NULL);
+	assert(cacheShard != NULL);
+	assert(cacheShard->clockCount > 0);
+
+	PackCacheEntry** clockEntries = cacheShard->clockEntries;
+	while (true)
+	{
+		if (cacheShard->clockHand >= cacheShard->clockCount)
+			cacheShard->clockHand = 0;
+
+		// NOTE: Recently read entries get a second chance before the eviction.
+		PackCacheEntry* cacheEntry = clockEntries[cacheShard->clockHand];
+		if (cacheEntry->isReferenced)
+		{
+			cacheEntry->isReferenced = false;
+			cacheShard->clockHand++;
+			continue;
+		}
+
+		clockEntries[cacheShard->clockHand] = clockEntries[--cacheShard->clockCount];
+		itemCache->entries[cacheEntry->itemIndex] = NULL;
+		cacheShard->cachedSize -= cacheEntry->dataSize;
+		cacheShard->evictionCount++;
+		releasePackCacheEntry(cacheEntry);
+		return;
+	}
+}
+static bool readCachedPackItem(PackItemCache* itemCache, uint64_t itemIndex, uint8_t* buffer)
+{
+	assert(itemCache != NULL);
+	assert(buffer != NULL);
 
-	PackItem searchItem;
-	searchItem.header.pathSize = (uint8_t)strlen(path);
-	searchItem.path = (char*)path;
+	PackCacheShard* cacheShard = getPackCacheShard(itemCache, itemIndex);
+	lockPackCacheShard(cacheShard);
 
-	PackItem* item = bsearch(&searchItem,
-		packReader->items, packReader->itemCount,
-		sizeof(PackItem), comparePackItems);
-	if (!item)
+	PackCacheEntry* cacheEntry = itemCache->entries[itemIndex];
+	if (!cacheEntry)
+	{
+		cacheShard->missCount++;
+		unlockPackCacheShard(cacheShard);
 		return false;
+	}
+
+	cacheEntry->isReferenced = true;
+	atomicFetchAdd32(&cacheEntry->refCount, 1);
+	cacheShard->hitCount++;
+	unlockPackCacheShard(cacheShard);
 
-	*index = item - packReader->items;
+	// NOTE: Copying outside the lock, entry can't be freed while we hold the reference.
+	memcpy(buffer, cacheEntry + 1, cacheEntry->dataSize);
+	releasePackCacheEntry(cacheEntry);
 	return true;
 }
+static void cachePackItem(PackItemCache* itemCache, uint64_t itemIndex, const uint8_t* data, uint32_t dataSize)
+{
+	assert(itemCache != NULL);
+	assert(data != NULL);
 
-uint32_t getPackItemDataSize(PackReader packReader, uint64_t index)
+	if (dataSize > itemCache->shardCapacity)
+		return;
+
+	PackCacheEntry* cacheEntry = malloc(sizeof(PackCacheEntry) + dataSize);
+	if (!cacheEntry)
+		return; // NOTE: Cache is optional, ignoring out of memory.
+
+	cacheEntry->itemIndex = itemIndex;
+	cacheEntry->dataSize = dataSize;
+	cacheEntry->refCount = 1;
+	cacheEntry->isReferenced = false;
+	memcpy(cacheEntry + 1, data, dataSize);
+
+	PackCacheShard* cacheShard = getPackCacheShard(itemCache, itemIndex);
+	lockPackCacheShard(cacheShard);
+
+	if (itemCache->entries[itemIndex]) // NOTE: Cached by another thread.
+	{
+		unlockPackCacheShard(cacheShard);
+		free(cacheEntry);
+		return;
+	}
+
+	if (cacheShard->clockCount == cacheShard->clockCapacity)
+	{
+		uint64_t clockCapacity = cacheShard->clockCapacity > 0 ? cacheShard->clockCapacity * 2 : 16;
+		PackCacheEntry** clockEntries = realloc(cacheShard->clockEntries, clockCapacity * sizeof(PackCacheEntry*));
+		if (!clockEntries)
+		{
+			unlockPackCacheShard(cacheShard);
+			free(cacheEntry);
+			return;
+		}
+
+		cacheShard->clockEntries = clockEntries;
+		cacheShard->clockCapacity = clockCapacity;
+	}
+
+	while (cacheShard->cachedSize + dataSize > itemCache->shardCapacity)
+		evictPackCacheEntry(itemCache, cacheShard);
+
+	cacheShard->clockEntries[cacheShard->clockCount++] = cacheEntry;
+	cacheShard->cachedSize += dataSize;
+	itemCache->entries[itemIndex] = cacheEntry;
+	unlockPackCacheShard(cacheShard);
+}
+static void clearPackItemCache(PackItemCache* itemCache)
+{
+	assert(itemCache != NULL);
+
+	PackCacheShard* cacheShards = itemCache->shards;
+	uint32_t shardCount = itemCache->shardCount;
+
+	for (uint32_t i = 0; i < shardCount; i++)
+	{
+		PackCacheShard* cacheShard = &cacheShards[i];
+		lockPackCacheShard(cacheShard);
+
+		PackCacheEntry** clockEntries = cacheShard->clockEntries;
+		uint64_t clockCount = cacheShard->clockCount;
+
+		for (uint64_t j = 0; j < clockCount; j++)
+		{
+			PackCacheEntry* cacheEntry = clockEntries[j];
+			itemCache->entries[cacheEntry->itemIndex] = NULL;
+			releasePackCacheEntry(cacheEntry);
+		}
+
+		cacheShard->clockCount = 0;
+		cacheShard->clockHand = 0;
+		cacheShard->cachedSize = 0;
+		unlockPackCacheShard(cacheShard);
+	}
+}
+static void destroyPackItemCache(PackItemCache* itemCache)
+{
+	if (!itemCache)
+		return;
+
+	if (itemCache->shards)
+	{
+		clearPackItemCache(itemCache);
+
+		PackCacheShard* cacheShards = itemCache->shards;
+		uint32_t shardCount = itemCache->shardCount;
+		for (uint32_t i = 0; i < shardCount; i++)
+			free(cacheShards[i].clockEntries);
+		free(cacheShards);
+	}
+
+	free(itemCache->entries);
+	free(itemCache);
+}
+
+/**********************************************************************************************************************/
+inline static void lockPackBlockCache(PackBlockCache* blockCache)
+{
+	assert(blockCache != NULL);
+	while (!atomicCompareExchange32(&blockCache->isLocked, 0, 1))
+	{
+		while (atomicLoad32(&blockCache->isLocked) != 0) { } // NOTE: Spinning on load to not bounce the cache line.
+	}
+}
+inline static void unlockPackBlockCache(PackBlockCache* blockCache)
+{
+	assert(blockCache != NULL);
+	atomicStore32(&blockCache->isLocked, 0);
+}
+
+static bool readCachedPackBlock(PackBlockCache* blockCache, 
+	const PackItemHeader* header, uint32_t offset, uint32_t length, uint8_t* buffer)
+{
+	assert(blockCache != NULL);
+	assert(header != NULL);
+	assert(buffer != NULL);
+
+	lockPackBlockCache(blockCache);
+	for (uint32_t i = 0; i < BLOCK_CACHE_SIZE; i++)
+	{
+		PackBlockEntry* blockEntry = &blockCache->entries[i];
+		if (blockEntry->dataOffset != header->dataOffset || 
+			(uint64_t)header->zipSize + offset + length > blockEntry->dataSize)
+		{
+			continue;
+		}
+
+		// NOTE: Solid items are small, so copying them under the lock is cheap.
+		memcpy(buffer, blockEntry->data + header->zipSize + offset, length);
+		blockEntry->useIndex = ++blockCache->useCounter;
+		unlockPackBlockCache(blockCache);
+		return true;
+	}
+	unlockPackBlockCache(blockCache);
+	return false;
+}
+static void cachePackBlock(PackBlockCache* blockCache, uint64_t dataOffset, uint8_t** blockData, uint32_t dataSize)
+{
+	assert(blockCache != NULL);
+	assert(blockData != NULL);
+
+	lockPackBlockCache(blockCache);
+	PackBlockEntry* targetEntry = NULL;
+	for (uint32_t i = 0; i < BLOCK_CACHE_SIZE; i++)
+	{
+		PackBlockEntry* blockEntry = &blockCache->entries[i];
+		if (blockEntry->dataOffset == dataOffset)
+		{
+			unlockPackBlockCache(blockCache); // NOTE: Already cached by another thread.
+			return;
+		}
+		if (!targetEntry || blockEntry->useIndex < targetEntry->useIndex)
+			targetEntry = blockEntry;
+	}
+
+	// NOTE: Swapping the least recently used block buffer, so decompressed data is not copied under the lock.
+	uint8_t* evictedData = targetEntry->data;
+	targetEntry->data = *blockData;
+	targetEntry->dataOffset = dataOffset;
+	targetEntry->dataSize = dataSize;
+	targetEntry->useIndex = ++blockCache->useCounter;
+	*blockData = evictedData;
+	unlockPackBlockCache(blockCache);
+}
+static void clearPackBlockCache(PackBlockCache* blockCache)
+{
+	assert(blockCache != NULL);
+
+	lockPackBlockCache(blockCache);
+	for (uint32_t i = 0; i < BLOCK_CACHE_SIZE; i++)
+	{
+		PackBlockEntry* blockEntry = &blockCache->entries[i];
+		free(blockEntry->data);
+		memset(blockEntry, 0, sizeof(PackBlockEntry));
+	}
+	unlockPackBlockCache(blockCache);
+}
+static void destroyPackBlockCache(PackBlockCache* blockCache)
+{
+	if (!blockCache)
+		return;
+
+	clearPackBlockCache(blockCache);
+	free(blockCache);
+}
+
+static PackResult createPackReaderInstance(uint32_t threadCount, PackReader* packReader)
 {
+	assert(threadCount > 0);
 	assert(packReader != NULL);
-	assert(index < packReader->itemCount);
-	return packReader->items[index].header.dataSize;
+
+	PackReader packReaderInstance = calloc(1, sizeof(PackReader_T));
+	if (!packReaderInstance)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	packReaderInstance->file = NULL_PACK_FILE;
+	packReaderInstance->threadCount = threadCount;
+
+	PackReadContext* readContexts = calloc(threadCount, sizeof(PackReadContext));
+	if (!readContexts)
+	{
+		destroyPackReader(packReaderInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	packReaderInstance->readContexts = readContexts;
+
+	uint32_t counterCount = MIN_READ_COUNTER_COUNT; // NOTE: Counter count should be a power of 2.
+	while (counterCount < threadCount)
+		counterCount *= 2;
+
+	PackReadCounters* readCounters = calloc(counterCount, sizeof(PackReadCounters));
+	if (!readCounters)
+	{
+		destroyPackReader(packReaderInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	packReaderInstance->readCounters = readCounters;
+	packReaderInstance->readCounterMask = counterCount - 1;
+
+	*packReader = packReaderInstance;
+	return SUCCESS_PACK_RESULT;
 }
+static PackResult openPackReaderFile(const char* filePath, bool isResourcesDirectory,
+	PackFile* file, uint64_t* fileSize, PackHeader* header)
+{
+	assert(filePath != NULL);
+	assert(file != NULL);
+	assert(fileSize != NULL);
+	assert(header != NULL);
 
-uint32_t getPackItemZipSize(PackReader packReader, uint64_t index)
+	char* path;
+	PackResult packResult = createPackFilePath(filePath, isResourcesDirectory, &path);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	packResult = openPackFile(path, file, fileSize);
+	destroyPackFilePath(filePath, path);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	if (*fileSize < sizeof(PackHeader))
+	{
+		closePackFile(*file);
+		return BAD_DATA_SIZE_PACK_RESULT;
+	}
+	if (!readPackFile(*file, 0, header, sizeof(PackHeader)))
+	{
+		closePackFile(*file);
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+
+	return SUCCESS_PACK_RESULT;
+}
+
+static PackResult initMappedPackReader(PackReader packReader, const PackHeader* header)
 {
 	assert(packReader != NULL);
-	assert(index < packReader->itemCount);
-	return packReader->items[index].header.zipSize;
+	assert(packReader->mappedData != NULL);
+	assert(header != NULL);
+
+	const uint8_t* mappedData = packReader->mappedData;
+	uint64_t mappedSize = packReader->mappedSize;
+	packReader->preferSpeed = header->preferSpeed ? true : false;
+
+	if (header->indexSize > mappedSize - sizeof(PackHeader) || 
+		header->dictionarySize > mappedSize - sizeof(PackHeader) - header->indexSize)
+	{
+		return BAD_DATA_SIZE_PACK_RESULT;
+	}
+
+	PackResult packResult = createPackItems(packReader, mappedData + sizeof(PackHeader), 
+		header->indexSize, header->itemCount, header->hasChecksums, mappedSize);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	packResult = createPackDictionary(packReader, mappedData + 
+		sizeof(PackHeader) + header->indexSize, header->dictionarySize);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+	return createPackZipContexts(packReader);
 }
 
-PackResult readPackItemData(PackReader packReader,
-	uint64_t itemIndex, uint8_t* buffer, uint32_t threadIndex)
+/**********************************************************************************************************************/
+PackResult createFilePackReader(const char* filePath, uint32_t dataVersion,
+	bool isResourcesDirectory, uint32_t threadCount, PackReader* packReader)
 {
-	assert(packReader);
-	assert(itemIndex < packReader->itemCount);
-	assert(buffer != NULL);
-	assert(threadIndex < packReader->threadCount);
+	assert(filePath != NULL);
+	assert(threadCount > 0);
+	assert(packReader != NULL);
+
+	PackReader packReaderInstance;
+	PackResult packResult = createPackReaderInstance(threadCount, &packReaderInstance);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	PackHeader header; uint64_t fileSize;
+	packResult = openPackReaderFile(filePath, isResourcesDirectory, 
+		&packReaderInstance->file, &fileSize, &header);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	packResult = checkPackHeader(&header, dataVersion);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	packReaderInstance->preferSpeed = header.preferSpeed ? true : false;
+
+	if (header.indexSize > fileSize - sizeof(PackHeader) || 
+		header.dictionarySize > fileSize - sizeof(PackHeader) - header.indexSize || 
+		header.indexSize + header.dictionarySize > SIZE_MAX)
+	{
+		destroyPackReader(packReaderInstance);
+		return BAD_DATA_SIZE_PACK_RESULT;
+	}
+
+	// NOTE: Compression dictionary is stored right after the index, so they are read together.
+	size_t indexDataSize = (size_t)(header.indexSize + header.dictionarySize);
+	uint8_t* indexData = malloc(indexDataSize);
+	if (!indexData)
+	{
+		destroyPackReader(packReaderInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	if (!readPackFile(packReaderInstance->file, sizeof(PackHeader), indexData, indexDataSize))
+	{
+		free(indexData);
+		destroyPackReader(packReaderInstance);
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+
+	packResult = createPackItems(packReaderInstance, indexData, 
+		header.indexSize, header.itemCount, header.hasChecksums, fileSize);
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		packResult = createPackDictionary(packReaderInstance, 
+			indexData + header.indexSize, header.dictionarySize);
+	}
+	free(indexData);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	packResult = createPackZipContexts(packReaderInstance);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	packResult = createPackZipBuffers(packReaderInstance);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	*packReader = packReaderInstance;
+	return SUCCESS_PACK_RESULT;
+}
+PackResult createMappedPackReader(const char* filePath, uint32_t dataVersion,
+	bool isResourcesDirectory, uint32_t threadCount, PackReader* packReader)
+{
+	assert(filePath != NULL);
+	assert(threadCount > 0);
+	assert(packReader != NULL);
+
+	PackReader packReaderInstance;
+	PackResult packResult = createPackReaderInstance(threadCount, &packReaderInstance);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	PackFile file; PackHeader header; uint64_t fileSize;
+	packResult = openPackReaderFile(filePath, isResourcesDirectory, &file, &fileSize, &header);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	packResult = checkPackHeader(&header, dataVersion);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		closePackFile(file);
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	const uint8_t* mappedData;
+	packResult = mapPackFile(file, fileSize, &mappedData);
+	closePackFile(file); // NOTE: mapping stays valid after closing the file.
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	packReaderInstance->mappedData = mappedData;
+	packReaderInstance->mappedSize = fileSize;
+
+	packResult = initMappedPackReader(packReaderInstance, &header);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	*packReader = packReaderInstance;
+	return SUCCESS_PACK_RESULT;
+}
+PackResult createMemoryPackReader(const void* data, size_t size, 
+	uint32_t dataVersion, uint32_t threadCount, PackReader* packReader)
+{
+	assert(data != NULL);
+	assert(threadCount > 0);
+	assert(packReader != NULL);
+
+	if (size < sizeof(PackHeader))
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	PackHeader header; // NOTE: Caller buffer may be not aligned.
+	memcpy(&header, data, sizeof(PackHeader));
+
+	PackResult packResult = checkPackHeader(&header, dataVersion);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	PackReader packReaderInstance;
+	packResult = createPackReaderInstance(threadCount, &packReaderInstance);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	packReaderInstance->mappedData = (const uint8_t*)data;
+	packReaderInstance->mappedSize = (uint64_t)size;
+	packReaderInstance->isMemoryData = true;
+
+	packResult = initMappedPackReader(packReaderInstance, &header);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		destroyPackReader(packReaderInstance);
+		return packResult;
+	}
+
+	*packReader = packReaderInstance;
+	return SUCCESS_PACK_RESULT;
+}
+void destroyPackReader(PackReader packReader)
+{
+	if (!packReader)
+		return;
+
+	destroyPackItemCache(packReader->itemCache);
+	destroyPackBlockCache(packReader->blockCache);
+	free(packReader->itemHeaders);
+
+	uint32_t threadCount = packReader->threadCount;
+	if (packReader->readContexts)
+	{
+		PackReadContext* readContexts = packReader->readContexts;
+		for (uint32_t i = 0; i < threadCount; i++)
+			destroyPackReadContext(&readContexts[i]);
+		free(readContexts);
+	}
+	if (packReader->zipContexts)
+	{
+		PackZipContext** zipContexts = packReader->zipContexts;
+		for (uint32_t i = 0; i < threadCount; i++)
+			destroyPackZipContext(zipContexts[i]);
+		free(zipContexts);
+	}
+	free(packReader->zstdContexts);
+	if (packReader->zipBuffers)
+	{
+		uint8_t** zipBuffers = packReader->zipBuffers;
+		for (uint32_t i = 0; i < threadCount; i++)
+			free(zipBuffers[i]);
+		free(zipBuffers);
+	}
+	if (packReader->mappedData && !packReader->isMemoryData)
+		unmapPackFile(packReader->mappedData, packReader->mappedSize);
+	if (packReader->file != NULL_PACK_FILE)
+		closePackFile(packReader->file);
+
+	if (packReader->zstdDictionary)
+		ZSTD_freeDDict(packReader->zstdDictionary);
+
+	free(packReader->dictionaryData);
+	free(packReader->zipBufferSizes);
+	free(packReader->readCounters);
+	free(packReader);
+}
+
+/**********************************************************************************************************************/
+uint64_t getPackItemCount(PackReader packReader)
+{
+	assert(packReader != NULL);
+	return packReader->itemCount;
+}
+
+bool getPackItemIndex(PackReader packReader, const char* path, uint64_t* index)
+{
+	assert(packReader != NULL);
+	assert(path != NULL);
+	assert(index != NULL);
+	assert(strlen(path) <= UINT8_MAX);
+
+	uint8_t pathSize = (uint8_t)strlen(path);
+	uint64_t pathHash = hashPackItemPath(path, pathSize);
+	uint32_t slotHash = (uint32_t)(pathHash >> 32);
+
+	const PackHashSlot* hashSlots = packReader->hashSlots;
+	uint64_t slotMask = packReader->hashSlotCount - 1;
+	uint64_t slotIndex = pathHash & slotMask;
+
+	PackReadCounters* counters = getLocalReadCounters(packReader);
+	addReadCounter(&counters->lookupCount, 1);
+
+	while (true)
+	{
+		PackHashSlot hashSlot = hashSlots[slotIndex];
+		if (hashSlot.itemIndex == 0)
+		{
+			addReadCounter(&counters->lookupMissCount, 1);
+			return false;
+		}
+
+		if (hashSlot.pathHash == slotHash)
+		{
+			uint64_t itemIndex = hashSlot.itemIndex - 1;
+			if (packReader->itemHeaders[itemIndex].pathSize == pathSize && memcmp(packReader->paths +
+				packReader->pathOffsets[itemIndex], path, pathSize) == 0)
+			{
+				*index = itemIndex;
+				return true;
+			}
+		}
+
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+}
+
+uint32_t getPackItemDataSize(PackReader packReader, uint64_t index)
+{
+	assert(packReader != NULL);
+	assert(index < packReader->itemCount);
+	return packReader->itemHeaders[index].dataSize;
+}
+
+uint32_t getPackItemZipSize(PackReader packReader, uint64_t index)
+{
+	assert(packReader != NULL);
+	assert(index < packReader->itemCount);
+	const PackItemHeader* header = &packReader->itemHeaders[index];
+	return header->isSolid ? 0 : header->zipSize;
+}
+
+/**********************************************************************************************************************/
+inline static bool isPackItemSeekable(const PackItemHeader* header)
+{
+	assert(header != NULL);
+	return header->zipSize > 0 && !header->isSolid && header->dataSize > PACK_FRAME_SIZE;
+}
+inline static uint32_t getPackFrameZipSize(const uint8_t* seekTable, uint32_t frameIndex)
+{
+	assert(seekTable != NULL);
+	uint32_t frameZipSize; // NOTE: Seek table can be unaligned inside the mapped file.
+	memcpy(&frameZipSize, seekTable + frameIndex * sizeof(uint32_t), sizeof(uint32_t));
+	return frameZipSize;
+}
+
+inline static PackResult verifyPackItemData(PackReader packReader, 
+	uint64_t itemIndex, const uint8_t* data, uint32_t dataSize)
+{
+	assert(packReader != NULL);
+	if (!packReader->verifyChecksums || !packReader->itemChecksums)
+		return SUCCESS_PACK_RESULT;
+	if (computePackChecksum(data, dataSize, 0) != packReader->itemChecksums[itemIndex])
+		return BAD_ITEM_CHECKSUM_PACK_RESULT;
+	return SUCCESS_PACK_RESULT;
+}
+
+static bool decompressPackFrame(PackReader packReader, PackZipContext* zipContext, bool preferSpeed, 
+	const uint8_t* zipData, uint32_t zipSize, uint8_t* buffer, uint32_t dataSize)
+{
+	assert(packReader != NULL);
+	assert(zipContext != NULL);
+	assert(zipData != NULL);
+	assert(buffer != NULL);
+
+	if (preferSpeed)
+	{
+		LZ4F_dctx* lz4Context = zipContext->lz4Context;
+		size_t frameSize = dataSize, frameZipSize = zipSize;
+		LZ4F_resetDecompressionContext(lz4Context);
+
+		size_t result = LZ4F_decompress_usingDict(lz4Context, buffer, &frameSize, zipData, 
+			&frameZipSize, packReader->dictionary, packReader->dictionarySize, NULL);
+		return result == 0 && frameSize == dataSize && frameZipSize == zipSize;
+	}
+
+	size_t result = ZSTD_decompressDCtx(zipContext->zstdContext, buffer, dataSize, zipData, zipSize);
+	return result == dataSize;
+}
+static PackResult decompressPackItemData(PackReader packReader, uint64_t itemIndex,
+	const PackItemHeader* header, const uint8_t* zipData, uint8_t* buffer, PackZipContext* zipContext)
+{
+	assert(packReader != NULL);
+	assert(header != NULL);
+	assert(zipData != NULL);
+	assert(buffer != NULL);
+
+	if (isPackItemSeekable(header))
+	{
+		uint32_t frameCount = getPackFrameCount(header->dataSize);
+		uint32_t zipOffset = frameCount * sizeof(uint32_t);
+		if (zipOffset > header->zipSize)
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+		for (uint32_t i = 0; i < frameCount; i++)
+		{
+			uint32_t frameZipSize = getPackFrameZipSize(zipData, i);
+			if (frameZipSize > header->zipSize - zipOffset)
+				return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+			uint32_t dataOffset = i * PACK_FRAME_SIZE;
+			uint32_t frameSize = header->dataSize - dataOffset;
+			if (frameSize > PACK_FRAME_SIZE)
+				frameSize = PACK_FRAME_SIZE;
+
+			if (!decompressPackFrame(packReader, zipContext, header->preferSpeed, 
+				zipData + zipOffset, frameZipSize, buffer + dataOffset, frameSize))
+			{
+				return FAILED_TO_DECOMPRESS_PACK_RESULT;
+			}
+			zipOffset += frameZipSize;
+		}
+
+		if (zipOffset != header->zipSize)
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+	}
+	else
+	{
+		if (!decompressPackFrame(packReader, zipContext, header->preferSpeed, 
+			zipData, header->zipSize, buffer, header->dataSize))
+		{
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+		}
+	}
+
+	// NOTE: Item is verified before caching, so cached data is never damaged.
+	PackResult packResult = verifyPackItemData(packReader, itemIndex, buffer, header->dataSize);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	if (packReader->itemCache)
+		cachePackItem(packReader->itemCache, itemIndex, buffer, header->dataSize);
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult readPackBlockItem(PackReader packReader, const PackItemHeader* header, uint32_t offset, 
+	uint32_t length, uint8_t* buffer, PackZipContext* zipContext, uint8_t** zipBuffer, size_t* zipBufferSize, 
+	PackReadCounters* counters)
+{
+	assert(packReader != NULL);
+	assert(header != NULL);
+	assert(header->isSolid);
+	assert(buffer != NULL);
+	assert(zipContext != NULL);
+	assert(counters != NULL);
+
+	PackBlockCache* blockCache = packReader->blockCache;
+	if (readCachedPackBlock(blockCache, header, offset, length, buffer))
+		return SUCCESS_PACK_RESULT;
+
+	uint64_t startTime = getPackTime();
+	PackBlockHeader blockHeader; const uint8_t* zipData;
+
+	if (packReader->mappedData)
+	{
+		// NOTE: Block header can be unaligned inside the mapped file.
+		memcpy(&blockHeader, packReader->mappedData + header->dataOffset, sizeof(PackBlockHeader));
+		if (blockHeader.zipSize > packReader->mappedSize - header->dataOffset - sizeof(PackBlockHeader))
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+		zipData = packReader->mappedData + header->dataOffset + sizeof(PackBlockHeader);
+	}
+	else
+	{
+		assert(zipBuffer != NULL);
+		assert(zipBufferSize != NULL);
+
+		if (!readPackFile(packReader->file, header->dataOffset, &blockHeader, sizeof(PackBlockHeader)))
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+		if (blockHeader.zipSize > blockHeader.dataSize || blockHeader.dataSize > PACK_BLOCK_SIZE)
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+		if (blockHeader.zipSize > *zipBufferSize)
+		{
+			uint8_t* newBuffer = realloc(*zipBuffer, blockHeader.zipSize);
+			if (!newBuffer)
+				return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+			*zipBuffer = newBuffer;
+			*zipBufferSize = blockHeader.zipSize;
+			countZipBufferSize(counters, blockHeader.zipSize);
+		}
+
+		if (!readPackFile(packReader->file, header->dataOffset + 
+			sizeof(PackBlockHeader), *zipBuffer, blockHeader.zipSize))
+		{
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+		}
+		zipData = *zipBuffer;
+
+		uint64_t readTime = getPackTime();
+		addReadCounter(&counters->readTime, readTime - startTime);
+		startTime = readTime;
+	}
+
+	if (blockHeader.zipSize > blockHeader.dataSize || blockHeader.dataSize > PACK_BLOCK_SIZE ||
+		(uint64_t)header->zipSize + offset + length > blockHeader.dataSize)
+	{
+		return FAILED_TO_DECOMPRESS_PACK_RESULT;
+	}
+
+	if (!zipContext->blockData)
+	{
+		zipContext->blockData = malloc(PACK_BLOCK_SIZE);
+		if (!zipContext->blockData)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	if (!decompressPackFrame(packReader, zipContext, header->preferSpeed, 
+		zipData, blockHeader.zipSize, zipContext->blockData, blockHeader.dataSize))
+	{
+		return FAILED_TO_DECOMPRESS_PACK_RESULT;
+	}
+
+	memcpy(buffer, zipContext->blockData + header->zipSize + offset, length);
+	addReadCounter(&counters->zipTime, getPackTime() - startTime);
+	addReadCounter(&counters->zipReadSize, blockHeader.zipSize);
+
+	cachePackBlock(blockCache, header->dataOffset, &zipContext->blockData, blockHeader.dataSize);
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult readPackItemDataWithContext(PackReader packReader, uint64_t itemIndex, const PackItemHeader* header, 
+	uint8_t* buffer, PackZipContext* zipContext, uint8_t** zipBuffer, size_t* zipBufferSize, PackReadCounters* counters)
+{
+	assert(packReader != NULL);
+	assert(header != NULL);
+	assert(buffer != NULL);
+	assert(counters != NULL);
+
+	PackResult packResult;
+	uint64_t startTime = getPackTime();
+
+	if (header->isSolid)
+	{
+		packResult = readPackBlockItem(packReader, header, 0, header->dataSize, 
+			buffer, zipContext, zipBuffer, zipBufferSize, counters);
+	}
+	else if (packReader->mappedData)
+	{
+		const uint8_t* itemData = packReader->mappedData + header->dataOffset;
+		if (header->zipSize > 0)
+		{
+			packResult = decompressPackItemData(packReader, itemIndex, header, itemData, buffer, zipContext);
+			addReadCounter(&counters->zipTime, getPackTime() - startTime);
+			addReadCounter(&counters->zipReadSize, header->zipSize);
+		}
+		else
+		{
+			memcpy(buffer, itemData, header->dataSize);
+			addReadCounter(&counters->readTime, getPackTime() - startTime);
+			addReadCounter(&counters->rawReadSize, header->dataSize);
+			packResult = SUCCESS_PACK_RESULT;
+		}
+	}
+	else if (header->zipSize > 0)
+	{
+		assert(zipBuffer != NULL);
+		assert(zipBufferSize != NULL);
+
+		if (header->zipSize > *zipBufferSize)
+		{
+			uint8_t* newBuffer = realloc(*zipBuffer, header->zipSize);
+			if (!newBuffer)
+				return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+			*zipBuffer = newBuffer;
+			*zipBufferSize = header->zipSize;
+			countZipBufferSize(counters, header->zipSize);
+		}
+
+		if (!readPackFile(packReader->file, header->dataOffset, *zipBuffer, header->zipSize))
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+
+		uint64_t readTime = getPackTime();
+		addReadCounter(&counters->readTime, readTime - startTime);
+		addReadCounter(&counters->zipReadSize, header->zipSize);
+
+		packResult = decompressPackItemData(packReader, itemIndex, header, *zipBuffer, buffer, zipContext);
+		addReadCounter(&counters->zipTime, getPackTime() - readTime);
+	}
+	else
+	{
+		if (!readPackFile(packReader->file, header->dataOffset, buffer, header->dataSize))
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+		addReadCounter(&counters->readTime, getPackTime() - startTime);
+		addReadCounter(&counters->rawReadSize, header->dataSize);
+		packResult = SUCCESS_PACK_RESULT;
+	}
+
+	// NOTE: Compressed items are verified while decompressing, before they are cached.
+	if (packResult == SUCCESS_PACK_RESULT && (header->zipSize == 0 || header->isSolid))
+		packResult = verifyPackItemData(packReader, itemIndex, buffer, header->dataSize);
+	if (packResult == SUCCESS_PACK_RESULT)
+		addReadCounter(&counters->itemReadCount, 1);
+	return packResult;
+}
+
+PackResult readPackItemData(PackReader packReader,
+	uint64_t itemIndex, uint8_t* buffer, uint32_t threadIndex)
+{
+	assert(packReader);
+	assert(itemIndex < packReader->itemCount);
+	assert(buffer != NULL);
+	assert(threadIndex < packReader->threadCount);
+
+	PackItemHeader header = packReader->itemHeaders[itemIndex];
+	PackItemCache* itemCache = packReader->itemCache;
+	if (header.zipSize > 0 && !header.isSolid && itemCache && readCachedPackItem(itemCache, itemIndex, buffer))
+		return SUCCESS_PACK_RESULT;
+
+	PackZipContext* zipContext = packReader->zipContexts[threadIndex];
+	PackReadCounters* counters = getThreadReadCounters(packReader, threadIndex);
+	if (packReader->mappedData)
+		return readPackItemDataWithContext(packReader, itemIndex, &header, buffer, zipContext, NULL, NULL, counters);
+
+	return readPackItemDataWithContext(packReader, itemIndex, &header, buffer, zipContext,
+		&packReader->zipBuffers[threadIndex], &packReader->zipBufferSizes[threadIndex], counters);
+}
+PackResult readPackItemDataConcurrent(PackReader packReader, uint64_t itemIndex, uint8_t* buffer)
+{
+	assert(packReader);
+	assert(itemIndex < packReader->itemCount);
+	assert(buffer != NULL);
+
+	PackItemHeader header = packReader->itemHeaders[itemIndex];
+	PackItemCache* itemCache = packReader->itemCache;
+	if (header.zipSize > 0 && !header.isSolid && itemCache && readCachedPackItem(itemCache, itemIndex, buffer))
+		return SUCCESS_PACK_RESULT;
+
+	PackReadContext temporaryContext, *readContext;
+	PackResult packResult = beginPackReadContext(packReader, &temporaryContext, &readContext);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	packResult = readPackItemDataWithContext(packReader, itemIndex, &header, buffer, readContext->zipContext, 
+		&readContext->zipBuffer, &readContext->zipBufferSize, getLocalReadCounters(packReader));
+	endPackReadContext(packReader, &temporaryContext, readContext);
+	return packResult;
+}
+
+static PackResult readPackItemRangeWithContext(PackReader packReader, const PackItemHeader* header, 
+	uint32_t offset, uint32_t length, uint8_t* buffer, PackReadContext* readContext, PackReadCounters* counters)
+{
+	assert(packReader != NULL);
+	assert(header != NULL);
+	assert(buffer != NULL);
+	assert(readContext != NULL);
+	assert(counters != NULL);
+
+	uint64_t startTime = getPackTime();
+
+	bool isSeekable = isPackItemSeekable(header);
+	uint32_t firstFrame = offset / PACK_FRAME_SIZE;
+	uint32_t lastFrame = (offset + length - 1) / PACK_FRAME_SIZE;
+	uint32_t tableSize = isSeekable ? getPackFrameCount(header->dataSize) * (uint32_t)sizeof(uint32_t) : 0;
+	uint32_t tablePrefixSize = isSeekable ? (lastFrame + 1) * (uint32_t)sizeof(uint32_t) : 0;
+	if (tableSize > header->zipSize)
+		return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+	const uint8_t* seekTable = NULL;
+	if (isSeekable)
+	{
+		if (packReader->mappedData)
+		{
+			seekTable = packReader->mappedData + header->dataOffset;
+		}
+		else
+		{
+			if (tablePrefixSize > readContext->zipBufferSize)
+			{
+				uint8_t* newBuffer = realloc(readContext->zipBuffer, tablePrefixSize);
+				if (!newBuffer)
+					return FAILED_TO_ALLOCATE_PACK_RESULT;
+				readContext->zipBuffer = newBuffer;
+				readContext->zipBufferSize = tablePrefixSize;
+				countZipBufferSize(counters, tablePrefixSize);
+			}
+
+			if (!readPackFile(packReader->file, header->dataOffset, readContext->zipBuffer, tablePrefixSize))
+				return FAILED_TO_READ_FILE_PACK_RESULT;
+			seekTable = readContext->zipBuffer;
+		}
+	}
+
+	// NOTE: Only frames that cover the requested range are read from the file.
+	uint64_t zipOffset = tableSize, rangeZipSize = 0;
+	for (uint32_t i = 0; i <= lastFrame; i++)
+	{
+		uint32_t frameZipSize = isSeekable ? getPackFrameZipSize(seekTable, i) : header->zipSize;
+		if (i < firstFrame)
+			zipOffset += frameZipSize;
+		else rangeZipSize += frameZipSize;
+	}
+
+	if (zipOffset + rangeZipSize > header->zipSize)
+		return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+	const uint8_t* zipData;
+	if (packReader->mappedData)
+	{
+		zipData = packReader->mappedData + header->dataOffset + zipOffset;
+	}
+	else
+	{
+		size_t zipBufferSize = tablePrefixSize + rangeZipSize;
+		if (zipBufferSize > readContext->zipBufferSize)
+		{
+			uint8_t* newBuffer = realloc(readContext->zipBuffer, zipBufferSize);
+			if (!newBuffer)
+				return FAILED_TO_ALLOCATE_PACK_RESULT;
+			readContext->zipBuffer = newBuffer;
+			readContext->zipBufferSize = zipBufferSize;
+			countZipBufferSize(counters, zipBufferSize);
+		}
+
+		seekTable = readContext->zipBuffer;
+		zipData = readContext->zipBuffer + tablePrefixSize;
+		if (!readPackFile(packReader->file, header->dataOffset + zipOffset, (uint8_t*)zipData, rangeZipSize))
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+
+	uint64_t readTime = getPackTime();
+	addReadCounter(&counters->readTime, readTime - startTime);
+	addReadCounter(&counters->zipReadSize, tablePrefixSize + rangeZipSize);
+
+	uint32_t rangeEnd = offset + length;
+	for (uint32_t i = firstFrame; i <= lastFrame; i++)
+	{
+		uint32_t frameZipSize = isSeekable ? getPackFrameZipSize(seekTable, i) : header->zipSize;
+		uint32_t dataOffset = i * PACK_FRAME_SIZE;
+		uint32_t frameSize = header->dataSize - dataOffset;
+		if (frameSize > PACK_FRAME_SIZE)
+			frameSize = PACK_FRAME_SIZE;
+
+		uint32_t copyOffset = offset > dataOffset ? offset - dataOffset : 0;
+		uint32_t copyEnd = rangeEnd - dataOffset < frameSize ? rangeEnd - dataOffset : frameSize;
+
+		if (copyOffset == 0 && copyEnd == frameSize)
+		{
+			if (!decompressPackFrame(packReader, readContext->zipContext, header->preferSpeed, 
+				zipData, frameZipSize, buffer + (dataOffset - offset), frameSize))
+			{
+				return FAILED_TO_DECOMPRESS_PACK_RESULT;
+			}
+		}
+		else
+		{
+			// NOTE: Partially requested frames are decompressed to the scratch buffer.
+			if (!readContext->frameBuffer)
+			{
+				readContext->frameBuffer = malloc(PACK_FRAME_SIZE);
+				if (!readContext->frameBuffer)
+					return FAILED_TO_ALLOCATE_PACK_RESULT;
+			}
+
+			if (!decompressPackFrame(packReader, readContext->zipContext, header->preferSpeed, 
+				zipData, frameZipSize, readContext->frameBuffer, frameSize))
+			{
+				return FAILED_TO_DECOMPRESS_PACK_RESULT;
+			}
+			memcpy(buffer + (dataOffset + copyOffset - offset), 
+				readContext->frameBuffer + copyOffset, copyEnd - copyOffset);
+		}
+		zipData += frameZipSize;
+	}
+
+	addReadCounter(&counters->zipTime, getPackTime() - readTime);
+	return SUCCESS_PACK_RESULT;
+}
+PackResult readPackItemRange(PackReader packReader, uint64_t itemIndex, 
+	uint32_t offset, uint32_t length, uint8_t* buffer)
+{
+	assert(packReader);
+	assert(itemIndex < packReader->itemCount);
+	assert(buffer != NULL);
+
+	PackItemHeader header = packReader->itemHeaders[itemIndex];
+	assert((uint64_t)offset + length <= header.dataSize);
+
+	if (length == 0)
+		return SUCCESS_PACK_RESULT;
+
+	PackReadCounters* counters = getLocalReadCounters(packReader);
+	if (header.zipSize == 0 && !header.isSolid)
+	{
+		uint64_t startTime = getPackTime();
+		if (packReader->mappedData)
+			memcpy(buffer, packReader->mappedData + header.dataOffset + offset, length);
+		else if (!readPackFile(packReader->file, header.dataOffset + offset, buffer, length))
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+
+		addReadCounter(&counters->readTime, getPackTime() - startTime);
+		addReadCounter(&counters->rawReadSize, length);
+		addReadCounter(&counters->itemReadCount, 1);
+		return SUCCESS_PACK_RESULT;
+	}
+
+	PackReadContext temporaryContext, *readContext;
+	PackResult packResult = beginPackReadContext(packReader, &temporaryContext, &readContext);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	if (header.isSolid)
+	{
+		packResult = readPackBlockItem(packReader, &header, offset, length, buffer, 
+			readContext->zipContext, &readContext->zipBuffer, &readContext->zipBufferSize, counters);
+	}
+	else
+	{
+		packResult = readPackItemRangeWithContext(packReader, 
+			&header, offset, length, buffer, readContext, counters);
+	}
+	endPackReadContext(packReader, &temporaryContext, readContext);
+
+	if (packResult == SUCCESS_PACK_RESULT)
+		addReadCounter(&counters->itemReadCount, 1);
+	return packResult;
+}
+static int comparePackBatchItems(const void* _a, const void* _b)
+{
+	// NOTE: a and b should not be NULL!
+	// Skipping here assertions for debug build speed.
+
+	const PackBatchItem* a = _a;
+	const PackBatchItem* b = _b;
+	if (a->dataOffset != b->dataOffset)
+		return a->dataOffset < b->dataOffset ? -1 : 1;
+	if (a->batchIndex != b->batchIndex)
+		return a->batchIndex < b->batchIndex ? -1 : 1;
+	return 0;
+}
+PackResult readPackItemsBatch(PackReader packReader, const uint64_t* itemIndices,
+	uint8_t** buffers, uint64_t itemCount, uint32_t threadIndex)
+{
+	assert(packReader);
+	assert(itemIndices != NULL);
+	assert(buffers != NULL);
+	assert(threadIndex < packReader->threadCount);
+
+	if (itemCount == 0)
+		return SUCCESS_PACK_RESULT;
+
+	PackBatchItem* batchItems = malloc(itemCount * sizeof(PackBatchItem));
+	if (!batchItems)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	const PackItemHeader* itemHeaders = packReader->itemHeaders;
+	PackItemCache* itemCache = packReader->itemCache;
+	uint64_t batchCount = 0;
+
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		assert(itemIndices[i] < packReader->itemCount);
+		assert(buffers[i] != NULL);
+
+		PackItemHeader header = itemHeaders[itemIndices[i]];
+		if (header.zipSize > 0 && !header.isSolid && itemCache && 
+			readCachedPackItem(itemCache, itemIndices[i], buffers[i]))
+			continue;
+
+		PackBatchItem batchItem;
+		batchItem.dataOffset = header.dataOffset;
+		batchItem.batchIndex = i;
+		batchItems[batchCount++] = batchItem;
+	}
+
+	// NOTE: Reading items in the file order turns random seeks into a mostly sequential sweep.
+	qsort(batchItems, batchCount, sizeof(PackBatchItem), comparePackBatchItems);
+
+	PackZipContext* zipContext = packReader->zipContexts[threadIndex];
+	PackReadCounters* counters = getThreadReadCounters(packReader, threadIndex);
+	if (packReader->mappedData)
+	{
+		for (uint64_t i = 0; i < batchCount; i++)
+		{
+			uint64_t batchIndex = batchItems[i].batchIndex;
+			PackItemHeader header = itemHeaders[itemIndices[batchIndex]];
+			PackResult packResult = readPackItemDataWithContext(packReader, itemIndices[batchIndex],
+				&header, buffers[batchIndex], zipContext, NULL, NULL, counters);
+
+			if (packResult != SUCCESS_PACK_RESULT)
+			{
+				free(batchItems);
+				return packResult;
+			}
+		}
+
+		free(batchItems);
+		return SUCCESS_PACK_RESULT;
+	}
+
+	uint8_t** zipBuffer = &packReader->zipBuffers[threadIndex];
+	size_t* zipBufferSize = &packReader->zipBufferSizes[threadIndex];
+
+	uint64_t runStart = 0;
+	while (runStart < batchCount)
+	{
+		PackItemHeader header = itemHeaders[itemIndices[batchItems[runStart].batchIndex]];
+		uint64_t readOffset = header.dataOffset;
+		uint64_t readEnd = readOffset + (header.zipSize > 0 ? header.zipSize : header.dataSize);
+		uint64_t runEnd = runStart + 1;
+
+		// NOTE: Solid items are read one by one, their siblings are served from the block cache.
+		bool isSolid = header.isSolid;
+		while (runEnd < batchCount && !isSolid)
+		{
+			header = itemHeaders[itemIndices[batchItems[runEnd].batchIndex]];
+			uint64_t itemEnd = header.dataOffset + (header.zipSize > 0 ? header.zipSize : header.dataSize);
+
+			if (header.isSolid || header.dataOffset > readEnd + MAX_BATCH_GAP_SIZE ||
+				(itemEnd > readEnd && itemEnd - readOffset > MAX_BATCH_READ_SIZE))
+			{
+				break;
+			}
+
+			if (itemEnd > readEnd)
+				readEnd = itemEnd;
+			runEnd++;
+		}
+
+		PackResult packResult;
+		if (runEnd - runStart == 1)
+		{
+			uint64_t batchIndex = batchItems[runStart].batchIndex;
+			header = itemHeaders[itemIndices[batchIndex]];
+			packResult = readPackItemDataWithContext(packReader, itemIndices[batchIndex], &header,
+				buffers[batchIndex], zipContext, zipBuffer, zipBufferSize, counters);
+
+			if (packResult != SUCCESS_PACK_RESULT)
+			{
+				free(batchItems);
+				return packResult;
+			}
+
+			runStart = runEnd;
+			continue;
+		}
+
+		uint64_t readSize = readEnd - readOffset;
+		if (readSize > *zipBufferSize)
+		{
+			uint8_t* newBuffer = realloc(*zipBuffer, readSize);
+			if (!newBuffer)
+			{
+				free(batchItems);
+				return FAILED_TO_ALLOCATE_PACK_RESULT;
+			}
+
+			*zipBuffer = newBuffer;
+			*zipBufferSize = readSize;
+			countZipBufferSize(counters, readSize);
+		}
+
+		uint64_t startTime = getPackTime();
+		if (!readPackFile(packReader->file, readOffset, *zipBuffer, readSize))
+		{
+			free(batchItems);
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+		}
+		addReadCounter(&counters->readTime, getPackTime() - startTime);
+
+		for (uint64_t i = runStart; i < runEnd; i++)
+		{
+			uint64_t batchIndex = batchItems[i].batchIndex;
+			header = itemHeaders[itemIndices[batchIndex]];
+			const uint8_t* itemData = *zipBuffer + (header.dataOffset - readOffset);
+
+			if (header.zipSize > 0)
+			{
+				startTime = getPackTime();
+				packResult = decompressPackItemData(packReader, itemIndices[batchIndex],
+					&header, itemData, buffers[batchIndex], zipContext);
+				if (packResult != SUCCESS_PACK_RESULT)
+				{
+					free(batchItems);
+					return packResult;
+				}
+
+				addReadCounter(&counters->zipTime, getPackTime() - startTime);
+				addReadCounter(&counters->zipReadSize, header.zipSize);
+			}
+			else
+			{
+				memcpy(buffers[batchIndex], itemData, header.dataSize);
+				addReadCounter(&counters->rawReadSize, header.dataSize);
+
+				packResult = verifyPackItemData(packReader, 
+					itemIndices[batchIndex], buffers[batchIndex], header.dataSize);
+				if (packResult != SUCCESS_PACK_RESULT)
+				{
+					free(batchItems);
+					return packResult;
+				}
+			}
+		}
+
+		addReadCounter(&counters->itemReadCount, runEnd - runStart);
+		runStart = runEnd;
+	}
+
+	free(batchItems);
+	return SUCCESS_PACK_RESULT;
+}
+inline static uint64_t getPackItemPrefetchSize(const PackItemHeader* header)
+{
+	assert(header != NULL);
+	if (header->isSolid) // NOTE: Compressed block size is unknown without reading its header.
+		return sizeof(PackBlockHeader) + PACK_BLOCK_SIZE;
+	return header->zipSize > 0 ? header->zipSize : header->dataSize;
+}
+PackResult prefetchPackItems(PackReader packReader, const uint64_t* itemIndices, uint64_t itemCount)
+{
+	assert(packReader);
+	assert(itemIndices != NULL);
+
+	// NOTE: Caller owned memory data is already resident, there is nothing to prefetch.
+	if (itemCount == 0 || packReader->isMemoryData)
+		return SUCCESS_PACK_RESULT;
+
+	PackBatchItem* batchItems = malloc(itemCount * sizeof(PackBatchItem));
+	if (!batchItems)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	const PackItemHeader* itemHeaders = packReader->itemHeaders;
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		assert(itemIndices[i] < packReader->itemCount);
+		PackBatchItem batchItem;
+		batchItem.dataOffset = itemHeaders[itemIndices[i]].dataOffset;
+		batchItem.batchIndex = i;
+		batchItems[i] = batchItem;
+	}
+
+	// NOTE: Merging nearby items into larger ranges reduces advise syscall count.
+	qsort(batchItems, itemCount, sizeof(PackBatchItem), comparePackBatchItems);
+
+	uint64_t runStart = 0;
+	while (runStart < itemCount)
+	{
+		PackItemHeader header = itemHeaders[itemIndices[batchItems[runStart].batchIndex]];
+		uint64_t readOffset = header.dataOffset;
+		uint64_t readEnd = readOffset + getPackItemPrefetchSize(&header);
+		uint64_t runEnd = runStart + 1;
+
+		while (runEnd < itemCount)
+		{
+			header = itemHeaders[itemIndices[batchItems[runEnd].batchIndex]];
+			uint64_t itemEnd = header.dataOffset + getPackItemPrefetchSize(&header);
+
+			if (header.dataOffset > readEnd + MAX_BATCH_GAP_SIZE ||
+				(itemEnd > readEnd && itemEnd - readOffset > MAX_BATCH_READ_SIZE))
+			{
+				break;
+			}
+
+			if (itemEnd > readEnd)
+				readEnd = itemEnd;
+			runEnd++;
+		}
+
+		if (packReader->mappedData && readEnd > packReader->mappedSize)
+			readEnd = packReader->mappedSize;
+		if (readEnd > readOffset) // NOTE: Zero length advice applies to the whole file.
+			advisePackFileRange(packReader->file, packReader->mappedData, readOffset, readEnd - readOffset);
+		runStart = runEnd;
+	}
+
+	free(batchItems);
+	return SUCCESS_PACK_RESULT;
+}
+
+const uint8_t* getPackItemDataPointer(PackReader packReader, uint64_t index)
+{
+	assert(packReader != NULL);
+	assert(index < packReader->itemCount);
+
+	if (!packReader->mappedData)
+		return NULL;
+
+	PackItemHeader header = packReader->itemHeaders[index];
+	if (header.zipSize > 0 || header.isSolid)
+		return NULL;
+	return packReader->mappedData + header.dataOffset;
+}
+
+/**********************************************************************************************************************/
+PackResult openPackItemStream(PackReader packReader, uint64_t itemIndex, PackItemStream* itemStream)
+{
+	assert(packReader != NULL);
+	assert(itemIndex < packReader->itemCount);
+	assert(itemStream != NULL);
+
+	PackItemStream itemStreamInstance = calloc(1, sizeof(PackItemStream_T));
+	if (!itemStreamInstance)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	PackItemHeader header = packReader->itemHeaders[itemIndex];
+	itemStreamInstance->packReader = packReader;
+	itemStreamInstance->header = header;
+
+	// NOTE: Streamed data is verified when the last item data chunk is read.
+	if (packReader->verifyChecksums && packReader->itemChecksums && !header.isSolid)
+	{
+		itemStreamInstance->itemChecksum = packReader->itemChecksums[itemIndex];
+		itemStreamInstance->verifyChecksum = true;
+	}
+
+	if (header.isSolid)
+	{
+		// NOTE: Solid items are small, so they are read whole and streamed from the memory.
+		uint8_t* zipBuffer = malloc(header.dataSize);
+		if (!zipBuffer)
+		{
+			closePackItemStream(itemStreamInstance);
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+		}
+		itemStreamInstance->zipBuffer = zipBuffer;
+
+		PackResult packResult = readPackItemDataConcurrent(packReader, itemIndex, zipBuffer);
+		if (packResult != SUCCESS_PACK_RESULT)
+		{
+			closePackItemStream(itemStreamInstance);
+			return packResult;
+		}
+
+		*itemStream = itemStreamInstance;
+		return SUCCESS_PACK_RESULT;
+	}
+	else if (header.zipSize > 0)
+	{
+		// NOTE: Seekable item frames are decompressed one after another, so seek table is skipped.
+		uint32_t tableSize = isPackItemSeekable(&header) ? 
+			getPackFrameCount(header.dataSize) * (uint32_t)sizeof(uint32_t) : 0;
+		if (tableSize > header.zipSize)
+		{
+			closePackItemStream(itemStreamInstance);
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+		}
+		itemStreamInstance->zipOffset = tableSize;
+
+		PackZipContext* zipContext = createPackZipContext(packReader);
+		if (!zipContext)
+		{
+			closePackItemStream(itemStreamInstance);
+			return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+		}
+		itemStreamInstance->zipContext = zipContext;
+
+		if (packReader->mappedData)
+		{
+			itemStreamInstance->zipInput = packReader->mappedData + header.dataOffset + tableSize;
+			itemStreamInstance->zipInputSize = header.zipSize - tableSize;
+			itemStreamInstance->zipOffset = header.zipSize;
+		}
+		else
+		{
+			size_t zipBufferSize = header.zipSize < STREAM_CHUNK_SIZE ? header.zipSize : STREAM_CHUNK_SIZE;
+			uint8_t* zipBuffer = malloc(zipBufferSize);
+			if (!zipBuffer)
+			{
+				closePackItemStream(itemStreamInstance);
+				return FAILED_TO_ALLOCATE_PACK_RESULT;
+			}
+			itemStreamInstance->zipBuffer = zipBuffer;
+			countZipBufferSize(getLocalReadCounters(packReader), zipBufferSize);
+		}
+	}
+
+	addReadCounter(&getLocalReadCounters(packReader)->itemReadCount, 1);
+	*itemStream = itemStreamInstance;
+	return SUCCESS_PACK_RESULT;
+}
+void closePackItemStream(PackItemStream itemStream)
+{
+	if (!itemStream)
+		return;
+
+	destroyPackZipContext(itemStream->zipContext);
+	free(itemStream->zipBuffer);
+	free(itemStream);
+}
+
+static PackResult readPackItemStreamData(PackItemStream itemStream, uint8_t* buffer, uint32_t bufferSize)
+{
+	assert(itemStream != NULL);
+	assert(buffer != NULL);
+
+	PackReader packReader = itemStream->packReader;
+	PackItemHeader header = itemStream->header;
+	uint64_t startTime = getPackTime();
+
+	if (packReader->mappedData)
+		memcpy(buffer, packReader->mappedData + header.dataOffset + itemStream->dataOffset, bufferSize);
+	else if (!readPackFile(packReader->file, header.dataOffset + itemStream->dataOffset, buffer, bufferSize))
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+
+	PackReadCounters* counters = getLocalReadCounters(packReader);
+	addReadCounter(&counters->readTime, getPackTime() - startTime);
+	addReadCounter(&counters->rawReadSize, bufferSize);
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult verifyPackItemStream(PackItemStream itemStream, const uint8_t* data, uint32_t dataSize)
+{
+	assert(itemStream != NULL);
+	if (!itemStream->verifyChecksum || dataSize == 0)
+		return SUCCESS_PACK_RESULT;
+
+	itemStream->checksum = computePackChecksum(data, dataSize, itemStream->checksum);
+	if (itemStream->dataOffset == itemStream->header.dataSize && itemStream->checksum != itemStream->itemChecksum)
+		return BAD_ITEM_CHECKSUM_PACK_RESULT;
+	return SUCCESS_PACK_RESULT;
+}
+PackResult readPackItemStream(PackItemStream itemStream, uint8_t* buffer, uint32_t bufferSize, uint32_t* readSize)
+{
+	assert(itemStream != NULL);
+	assert(buffer != NULL);
+	assert(bufferSize > 0);
+	assert(readSize != NULL);
+
+	PackReader packReader = itemStream->packReader;
+	PackItemHeader header = itemStream->header;
+	uint32_t dataSize = header.dataSize;
+
+	if (header.zipSize == 0 || header.isSolid)
+	{
+		uint32_t chunkSize = dataSize - itemStream->dataOffset;
+		if (chunkSize > bufferSize)
+			chunkSize = bufferSize;
+
+		if (header.isSolid)
+		{
+			memcpy(buffer, itemStream->zipBuffer + itemStream->dataOffset, chunkSize);
+		}
+		else if (chunkSize > 0)
+		{
+			PackResult packResult = readPackItemStreamData(itemStream, buffer, chunkSize);
+			if (packResult != SUCCESS_PACK_RESULT)
+				return packResult;
+		}
+
+		itemStream->dataOffset += chunkSize;
+		*readSize = chunkSize;
+		return header.isSolid ? SUCCESS_PACK_RESULT : verifyPackItemStream(itemStream, buffer, chunkSize);
+	}
+
+	PackReadCounters* counters = getLocalReadCounters(packReader);
+	uint32_t outputSize = 0;
+
+	while (outputSize < bufferSize && itemStream->dataOffset < dataSize)
+	{
+		if (itemStream->zipInputOffset == itemStream->zipInputSize && itemStream->zipOffset < header.zipSize)
+		{
+			uint32_t chunkSize = header.zipSize - itemStream->zipOffset;
+			if (chunkSize > STREAM_CHUNK_SIZE)
+				chunkSize = STREAM_CHUNK_SIZE;
+
+			uint64_t startTime = getPackTime();
+			if (!readPackFile(packReader->file, header.dataOffset + 
+				itemStream->zipOffset, itemStream->zipBuffer, chunkSize))
+			{
+				return FAILED_TO_READ_FILE_PACK_RESULT;
+			}
+			addReadCounter(&counters->readTime, getPackTime() - startTime);
+
+			itemStream->zipInput = itemStream->zipBuffer;
+			itemStream->zipInputSize = chunkSize;
+			itemStream->zipInputOffset = 0;
+			itemStream->zipOffset += chunkSize;
+		}
+
+		size_t inputSize = itemStream->zipInputSize - itemStream->zipInputOffset;
+		size_t chunkSize = bufferSize - outputSize;
+		uint64_t startTime = getPackTime();
+
+		if (itemStream->header.preferSpeed)
+		{
+			size_t result = LZ4F_decompress_usingDict(itemStream->zipContext->lz4Context, 
+				buffer + outputSize, &chunkSize, itemStream->zipInput + itemStream->zipInputOffset, 
+				&inputSize, packReader->dictionary, packReader->dictionarySize, NULL);
+			if (LZ4F_isError(result))
+				return FAILED_TO_DECOMPRESS_PACK_RESULT;
+		}
+		else
+		{
+			ZSTD_inBuffer input = { itemStream->zipInput, itemStream->zipInputSize, itemStream->zipInputOffset };
+			ZSTD_outBuffer output = { buffer + outputSize, chunkSize, 0 };
+			size_t result = ZSTD_decompressStream(itemStream->zipContext->zstdContext, &output, &input);
+			if (ZSTD_isError(result))
+				return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+			inputSize = input.pos - itemStream->zipInputOffset;
+			chunkSize = output.pos;
+		}
+
+		// NOTE: No progress means that compressed data is truncated.
+		if ((inputSize == 0 && chunkSize == 0) || chunkSize > dataSize - itemStream->dataOffset)
+			return FAILED_TO_DECOMPRESS_PACK_RESULT;
+
+		addReadCounter(&counters->zipTime, getPackTime() - startTime);
+		addReadCounter(&counters->zipReadSize, inputSize);
+
+		itemStream->zipInputOffset += inputSize;
+		itemStream->dataOffset += (uint32_t)chunkSize;
+		outputSize += (uint32_t)chunkSize;
+	}
+
+	*readSize = outputSize;
+	return verifyPackItemStream(itemStream, buffer, outputSize);
+}
+
+uint32_t getPackItemStreamOffset(PackItemStream itemStream)
+{
+	assert(itemStream != NULL);
+	return itemStream->dataOffset;
+}
+
+/**********************************************************************************************************************/
+PackResult createPackReadQueue(PackReader packReader, uint32_t queueDepth, 
+	OnPackItemRead onItemRead, PackReadQueue* readQueue)
+{
+	assert(packReader != NULL);
+	assert(queueDepth > 0);
+	assert(onItemRead != NULL);
+	assert(readQueue != NULL);
+
+	PackReadQueue readQueueInstance = calloc(1, sizeof(PackReadQueue_T));
+	if (!readQueueInstance)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	readQueueInstance->packReader = packReader;
+	readQueueInstance->onItemRead = onItemRead;
+	readQueueInstance->queueDepth = queueDepth;
+	readQueueInstance->freeCount = queueDepth;
+
+	PackReadRequest* requests = calloc(queueDepth, sizeof(PackReadRequest));
+	if (!requests)
+	{
+		destroyPackReadQueue(readQueueInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	readQueueInstance->requests = requests;
+
+	uint32_t* freeRequests = malloc(queueDepth * sizeof(uint32_t));
+	if (!freeRequests)
+	{
+		destroyPackReadQueue(readQueueInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	readQueueInstance->freeRequests = freeRequests;
+
+	for (uint32_t i = 0; i < queueDepth; i++)
+		freeRequests[i] = queueDepth - (i + 1);
+
+	PackZipContext* zipContext = createPackZipContext(packReader);
+	if (!zipContext)
+	{
+		destroyPackReadQueue(readQueueInstance);
+		return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+	}
+	readQueueInstance->zipContext = zipContext;
+
+	#if PACK_IO_URING
+	// NOTE: Falling back to the synchronous reads if io_uring is disabled in the kernel.
+	if (!packReader->mappedData)
+		readQueueInstance->isAsync = createPackUring(queueDepth, &readQueueInstance->ring);
+	#endif
+
+	*readQueue = readQueueInstance;
+	return SUCCESS_PACK_RESULT;
+}
+void destroyPackReadQueue(PackReadQueue readQueue)
+{
+	if (!readQueue)
+		return;
+
+	if (readQueue->pendingCount > 0)
+	{
+		if (processPackReadQueue(readQueue, true) != SUCCESS_PACK_RESULT)
+			abort(); // NOTE: Kernel may still write to the freed buffers.
+	}
+
+	#if PACK_IO_URING
+	if (readQueue->isAsync)
+		destroyPackUring(&readQueue->ring);
+	#endif
+
+	destroyPackZipContext(readQueue->zipContext);
+
+	PackReadRequest* requests = readQueue->requests;
+	if (requests)
+	{
+		uint32_t queueDepth = readQueue->queueDepth;
+		for (uint32_t i = 0; i < queueDepth; i++)
+			free(requests[i].zipBuffer);
+		free(requests);
+	}
+
+	free(readQueue->freeRequests);
+	free(readQueue);
+}
+
+#if PACK_IO_URING
+static bool queuePackItemRead(PackReadQueue readQueue, uint32_t requestIndex)
+{
+	assert(readQueue != NULL);
+	assert(requestIndex < readQueue->queueDepth);
+
+	PackReader packReader = readQueue->packReader;
+	PackReadRequest* request = &readQueue->requests[requestIndex];
+	PackItemHeader header = packReader->itemHeaders[request->itemIndex];
+	uint8_t* readBuffer = header.zipSize > 0 ? request->zipBuffer : request->buffer;
+	uint32_t readSize = header.zipSize > 0 ? header.zipSize : header.dataSize;
+
+	PackUring* ring = &readQueue->ring;
+	uint64_t fileOffset = header.dataOffset + request->readSize;
+	readBuffer += request->readSize;
+	readSize -= request->readSize;
+
+	if (queuePackUringRead(ring, packReader->file, fileOffset, readBuffer, readSize, requestIndex))
+		return true;
+	if (!submitPackUring(ring, 0))
+		return false;
+	return queuePackUringRead(ring, packReader->file, fileOffset, readBuffer, readSize, requestIndex);
+}
+static void completePackItemRead(PackReadQueue readQueue, uint32_t requestIndex, PackResult packResult)
+{
+	assert(readQueue != NULL);
+	assert(requestIndex < readQueue->queueDepth);
+
+	PackReadRequest request = readQueue->requests[requestIndex];
+	readQueue->freeRequests[readQueue->freeCount++] = requestIndex;
+	readQueue->pendingCount--;
+
+	// NOTE: Request slot is already free, so completion function is able to submit a new read.
+	readQueue->onItemRead(request.itemIndex, request.buffer, packResult, request.argument);
+}
+static PackResult processPackReadCompletions(PackReadQueue readQueue, uint32_t waitCount)
+{
+	assert(readQueue != NULL);
+
+	PackUring* ring = &readQueue->ring;
+	if (!submitPackUring(ring, waitCount))
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+
+	PackReader packReader = readQueue->packReader;
+	const PackItemHeader* itemHeaders = packReader->itemHeaders;
+	PackReadRequest* requests = readQueue->requests;
+	PackReadCounters* counters = getLocalReadCounters(packReader);
+
+	while (true)
+	{
+		struct io_uring_cqe* cqe = peekPackUring(ring);
+		if (!cqe)
+			break;
+
+		uint32_t requestIndex = (uint32_t)cqe->user_data;
+		int32_t readResult = cqe->res;
+		advancePackUring(ring);
+
+		PackReadRequest* request = &requests[requestIndex];
+		PackItemHeader header = itemHeaders[request->itemIndex];
+		uint32_t readSize = header.zipSize > 0 ? header.zipSize : header.dataSize;
+
+		if (readResult > 0)
+			request->readSize += (uint32_t)readResult;
+
+		// NOTE: Continuing interrupted or short reads from the last read position.
+		if (readResult == -EINTR || readResult == -EAGAIN || (readResult > 0 && request->readSize < readSize))
+		{
+			if (!queuePackItemRead(readQueue, requestIndex))
+				completePackItemRead(readQueue, requestIndex, FAILED_TO_READ_FILE_PACK_RESULT);
+			continue;
+		}
+
+		PackResult packResult;
+		if (readResult <= 0)
+		{
+			packResult = FAILED_TO_READ_FILE_PACK_RESULT;
+		}
+		else if (header.zipSize > 0)
+		{
+			uint64_t startTime = getPackTime();
+			packResult = decompressPackItemData(packReader, request->itemIndex, &header, 
+				request->zipBuffer, request->buffer, readQueue->zipContext);
+			addReadCounter(&counters->zipTime, getPackTime() - startTime);
+			addReadCounter(&counters->zipReadSize, header.zipSize);
+		}
+		else
+		{
+			addReadCounter(&counters->rawReadSize, header.dataSize);
+			packResult = verifyPackItemData(packReader, request->itemIndex, request->buffer, header.dataSize);
+		}
+
+		if (packResult == SUCCESS_PACK_RESULT)
+			addReadCounter(&counters->itemReadCount, 1);
+		completePackItemRead(readQueue, requestIndex, packResult);
+	}
+
+	return SUCCESS_PACK_RESULT;
+}
+#endif
+
+PackResult submitPackItemRead(PackReadQueue readQueue, uint64_t itemIndex, uint8_t* buffer, void* argument)
+{
+	assert(readQueue != NULL);
+	assert(itemIndex < readQueue->packReader->itemCount);
+	assert(buffer != NULL);
 
-	PackItemHeader header = packReader->items[itemIndex].header;
-	FILE* file = packReader->files[threadIndex];
-	int seekResult = seekFile(file, header.dataOffset, SEEK_SET);
-	if (seekResult != 0)
-		return FAILED_TO_SEEK_FILE_PACK_RESULT;
+	PackReader packReader = readQueue->packReader;
+	PackItemHeader header = packReader->itemHeaders[itemIndex];
+	PackItemCache* itemCache = packReader->itemCache;
 
-	if (header.zipSize > 0)
+	if (header.zipSize > 0 && !header.isSolid && itemCache && readCachedPackItem(itemCache, itemIndex, buffer))
 	{
-		uint8_t* zipBuffer = packReader->zipBuffers[threadIndex];
-		if (header.zipSize > packReader->zipBufferSizes[threadIndex])
+		readQueue->onItemRead(itemIndex, buffer, SUCCESS_PACK_RESULT, argument);
+		return SUCCESS_PACK_RESULT;
+	}
+	if (header.isSolid)
+	{
+		// NOTE: Solid items are read synchronously, their blocks are mostly served from the block cache.
+		PackResult packResult = readPackItemDataConcurrent(packReader, itemIndex, buffer);
+		readQueue->onItemRead(itemIndex, buffer, packResult, argument);
+		return SUCCESS_PACK_RESULT;
+	}
+
+	#if PACK_IO_URING
+	if (readQueue->isAsync)
+	{
+		while (readQueue->freeCount == 0)
 		{
-			zipBuffer = realloc(zipBuffer, header.zipSize);
-			if (!zipBuffer)
+			PackResult packResult = processPackReadCompletions(readQueue, 1);
+			if (packResult != SUCCESS_PACK_RESULT)
+				return packResult;
+		}
+
+		uint32_t requestIndex = readQueue->freeRequests[readQueue->freeCount - 1];
+		PackReadRequest* request = &readQueue->requests[requestIndex];
+
+		if (header.zipSize > request->zipBufferSize)
+		{
+			uint8_t* newBuffer = realloc(request->zipBuffer, header.zipSize);
+			if (!newBuffer)
 				return FAILED_TO_ALLOCATE_PACK_RESULT;
 
-			packReader->zipBuffers[threadIndex] = zipBuffer;
-			packReader->zipBufferSizes[threadIndex] = header.zipSize;
+			request->zipBuffer = newBuffer;
+			request->zipBufferSize = header.zipSize;
+			countZipBufferSize(getLocalReadCounters(packReader), header.zipSize);
 		}
 
-		if (fread(zipBuffer, sizeof(uint8_t), header.zipSize, file) != header.zipSize)
+		request->buffer = buffer;
+		request->argument = argument;
+		request->itemIndex = itemIndex;
+		request->readSize = 0;
+
+		if (!queuePackItemRead(readQueue, requestIndex))
 			return FAILED_TO_READ_FILE_PACK_RESULT;
 
-		if (packReader->preferSpeed)
-		{
-			int result = LZ4_decompress_safe((const char*)zipBuffer, 
-				(char*)buffer, (int)header.zipSize, (int)header.dataSize);
-			if (result != header.dataSize)
-				return FAILED_TO_DECOMPRESS_PACK_RESULT;
-		}
-		else
-		{
-			ZSTD_DCtx* zipContext = (ZSTD_DCtx*)packReader->zipContexts[threadIndex];
-			size_t result = ZSTD_decompressDCtx(zipContext, buffer, header.dataSize, zipBuffer, header.zipSize);
-			if (result != header.dataSize)
-				return FAILED_TO_DECOMPRESS_PACK_RESULT;
-		}
+		readQueue->freeCount--;
+		readQueue->pendingCount++;
+		return SUCCESS_PACK_RESULT;
 	}
-	else
+	#endif
+
+	PackReadRequest* request = &readQueue->requests[0];
+	PackResult packResult = readPackItemDataWithContext(packReader, itemIndex, &header, buffer, readQueue->zipContext, 
+		&request->zipBuffer, &request->zipBufferSize, getLocalReadCounters(packReader));
+	readQueue->onItemRead(itemIndex, buffer, packResult, argument);
+	return SUCCESS_PACK_RESULT;
+}
+PackResult processPackReadQueue(PackReadQueue readQueue, bool waitAll)
+{
+	assert(readQueue != NULL);
+
+	#if PACK_IO_URING
+	if (readQueue->isAsync)
 	{
-		size_t result = fread(buffer, sizeof(uint8_t), header.dataSize, file);
-		if (result != header.dataSize)
-			return FAILED_TO_READ_FILE_PACK_RESULT;
+		PackResult packResult = processPackReadCompletions(readQueue, 0);
+		while (packResult == SUCCESS_PACK_RESULT && waitAll && readQueue->pendingCount > 0)
+			packResult = processPackReadCompletions(readQueue, 1);
+		return packResult;
 	}
+	#endif
 
-	return SUCCESS_PACK_RESULT;
+	(void)waitAll;
+	return SUCCESS_PACK_RESULT; // NOTE: Synchronous reads are completed on submit.
+}
+
+uint32_t getPackReadQueuePendingCount(PackReadQueue readQueue)
+{
+	assert(readQueue != NULL);
+	return readQueue->pendingCount;
+}
+bool isPackReadQueueAsync(PackReadQueue readQueue)
+{
+	assert(readQueue != NULL);
+	return readQueue->isAsync;
 }
 
 /**********************************************************************************************************************/
@@ -444,21 +2833,44 @@ uint64_t getPackItemFileOffset(PackReader packReader, uint64_t index)
 {
 	assert(packReader != NULL);
 	assert(index < packReader->itemCount);
-	return packReader->items[index].header.dataOffset;
+	return packReader->itemHeaders[index].dataOffset;
 }
 
 bool isPackItemReference(PackReader packReader, uint64_t index)
 {
 	assert(packReader != NULL);
 	assert(index < packReader->itemCount);
-	return packReader->items[index].header.isReference;
+	return packReader->itemHeaders[index].isReference;
+}
+bool isPackItemPreferSpeed(PackReader packReader, uint64_t index)
+{
+	assert(packReader != NULL);
+	assert(index < packReader->itemCount);
+	return packReader->itemHeaders[index].preferSpeed;
+}
+bool isPackItemSolid(PackReader packReader, uint64_t index)
+{
+	assert(packReader != NULL);
+	assert(index < packReader->itemCount);
+	return packReader->itemHeaders[index].isSolid;
+}
+bool getPackItemChecksum(PackReader packReader, uint64_t index, uint32_t* checksum)
+{
+	assert(packReader != NULL);
+	assert(index < packReader->itemCount);
+	assert(checksum != NULL);
+
+	if (!packReader->itemChecksums)
+		return false;
+	*checksum = packReader->itemChecksums[index];
+	return true;
 }
 
 const char* getPackItemPath(PackReader packReader, uint64_t index)
 {
 	assert(packReader != NULL);
 	assert(index < packReader->itemCount);
-	return packReader->items[index].path;
+	return packReader->paths + packReader->pathOffsets[index];
 }
 
 bool isPackPreferSpeed(PackReader packReader)
@@ -466,12 +2878,17 @@ bool isPackPreferSpeed(PackReader packReader)
 	assert(packReader != NULL);
 	return packReader->preferSpeed;
 }
+bool isPackReaderMapped(PackReader packReader)
+{
+	assert(packReader != NULL);
+	return packReader->mappedData != NULL;
+}
 
 void** const getPackZstdContexts(PackReader packReader)
 {
 	assert(packReader != NULL);
-	if (packReader->preferSpeed) abort();
-	return (void** const)packReader->zipContexts;
+	if (!packReader->zstdContexts) abort();
+	return (void** const)packReader->zstdContexts;
 }
 uint32_t getPackThreadCount(PackReader packReader)
 {
@@ -483,10 +2900,31 @@ void shrinkPack(PackReader packReader)
 {
 	assert(packReader != NULL);
 
+	if (packReader->itemCache)
+		clearPackItemCache(packReader->itemCache);
+	if (packReader->blockCache)
+		clearPackBlockCache(packReader->blockCache);
+
 	uint8_t** zipBuffers = packReader->zipBuffers;
 	size_t* zipBufferSizes = packReader->zipBufferSizes;
 	uint32_t threadCount = packReader->threadCount;
 
+	PackReadContext* readContexts = packReader->readContexts;
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		PackReadContext* readContext = &readContexts[i];
+		if (!atomicCompareExchange32(&readContext->isBusy, 0, 1))
+			continue;
+
+		free(readContext->zipBuffer);
+		readContext->zipBuffer = NULL;
+		readContext->zipBufferSize = 0;
+		releasePackReadContext(readContext);
+	}
+
+	if (!zipBuffers)
+		return;
+
 	for (uint32_t i = 0; i < threadCount; i++)
 	{
 		uint8_t* zipBuffer = realloc(zipBuffers[i], 16);
@@ -498,125 +2936,484 @@ void shrinkPack(PackReader packReader)
 	}
 }
 
+void setPackReaderAccess(PackReader packReader, PackAccess access)
+{
+	assert(packReader != NULL);
+	assert(access < PACK_ACCESS_COUNT);
+
+	if (!packReader->isMemoryData)
+		advisePackFileAccess(packReader->file, packReader->mappedData, packReader->mappedSize, access);
+	packReader->access = access;
+}
+PackAccess getPackReaderAccess(PackReader packReader)
+{
+	assert(packReader != NULL);
+	return packReader->access;
+}
+void setPackReaderVerify(PackReader packReader, bool verifyChecksums)
+{
+	assert(packReader != NULL);
+	packReader->verifyChecksums = verifyChecksums;
+}
+bool isPackReaderVerify(PackReader packReader)
+{
+	assert(packReader != NULL);
+	return packReader->verifyChecksums;
+}
+
 /**********************************************************************************************************************/
-static void removePackItemFiles(uint64_t itemCount, PackItem* packItems)
+PackResult setPackItemCacheCapacity(PackReader packReader, uint64_t capacity)
+{
+	assert(packReader != NULL);
+
+	destroyPackItemCache(packReader->itemCache);
+	packReader->itemCache = NULL;
+
+	if (capacity == 0)
+		return SUCCESS_PACK_RESULT;
+
+	uint32_t shardCount = 1; // NOTE: Shard count should be a power of 2.
+	while (shardCount < MAX_CACHE_SHARD_COUNT && shardCount / 2 < packReader->threadCount)
+		shardCount *= 2;
+
+	PackItemCache* itemCache = calloc(1, sizeof(PackItemCache));
+	if (!itemCache)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	itemCache->capacity = capacity;
+	itemCache->shardCapacity = capacity / shardCount;
+	itemCache->shardCount = shardCount;
+
+	PackCacheEntry** entries = calloc(packReader->itemCount, sizeof(PackCacheEntry*));
+	if (!entries)
+	{
+		destroyPackItemCache(itemCache);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	itemCache->entries = entries;
+
+	PackCacheShard* cacheShards = calloc(shardCount, sizeof(PackCacheShard));
+	if (!cacheShards)
+	{
+		destroyPackItemCache(itemCache);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	itemCache->shards = cacheShards;
+
+	packReader->itemCache = itemCache;
+	return SUCCESS_PACK_RESULT;
+}
+uint64_t getPackItemCacheCapacity(PackReader packReader)
 {
-	assert(itemCount == 0 || (itemCount > 0 && packItems != NULL));
-	for (uint64_t i = 0; i < itemCount; i++) remove(packItems[i].path);
+	assert(packReader != NULL);
+	return packReader->itemCache ? packReader->itemCache->capacity : 0;
 }
-PackResult unpackFiles(const char* filePath, bool printProgress)
+void getPackItemCacheStats(PackReader packReader, PackCacheStats* stats)
 {
-	assert(filePath != NULL);
+	assert(packReader != NULL);
+	assert(stats != NULL);
 
-	PackReader packReader; // TODO: do this from multiple threads.
-	PackResult packResult = createFilePackReader(filePath, 0, false, 1, &packReader);
-	if (packResult != SUCCESS_PACK_RESULT)
-		return packResult;
+	memset(stats, 0, sizeof(PackCacheStats));
 
-	uint64_t rawFileSize = 0;
-	uint64_t fileOffset = sizeof(PackHeader);
-	uint64_t itemCount = packReader->itemCount;
-	PackItem* items = packReader->items;
+	PackItemCache* itemCache = packReader->itemCache;
+	if (!itemCache)
+		return;
 
-	for (uint64_t i = 0; i < itemCount; i++)
+	PackCacheShard* cacheShards = itemCache->shards;
+	uint32_t shardCount = itemCache->shardCount;
+
+	for (uint32_t i = 0; i < shardCount; i++)
 	{
-		const PackItem* item = &items[i];
-		if (printProgress)
+		PackCacheShard* cacheShard = &cacheShards[i];
+		lockPackCacheShard(cacheShard);
+		stats->hitCount += cacheShard->hitCount;
+		stats->missCount += cacheShard->missCount;
+		stats->evictionCount += cacheShard->evictionCount;
+		stats->itemCount += cacheShard->clockCount;
+		stats->cachedSize += cacheShard->cachedSize;
+		unlockPackCacheShard(cacheShard);
+	}
+}
+void getPackReaderStats(PackReader packReader, PackReaderStats* stats)
+{
+	assert(packReader != NULL);
+	assert(stats != NULL);
+
+	memset(stats, 0, sizeof(PackReaderStats));
+
+	PackReadCounters* readCounters = packReader->readCounters;
+	uint32_t counterCount = packReader->readCounterMask + 1;
+
+	for (uint32_t i = 0; i < counterCount; i++)
+	{
+		PackReadCounters* counters = &readCounters[i];
+		stats->itemReadCount += (uint64_t)atomicLoad64(&counters->itemReadCount);
+		stats->zipReadSize += (uint64_t)atomicLoad64(&counters->zipReadSize);
+		stats->rawReadSize += (uint64_t)atomicLoad64(&counters->rawReadSize);
+		stats->readTime += (uint64_t)atomicLoad64(&counters->readTime);
+		stats->zipTime += (uint64_t)atomicLoad64(&counters->zipTime);
+		stats->lookupCount += (uint64_t)atomicLoad64(&counters->lookupCount);
+		stats->lookupMissCount += (uint64_t)atomicLoad64(&counters->lookupMissCount);
+
+		uint64_t zipBufferSize = (uint64_t)atomicLoad64(&counters->zipBufferSize);
+		if (zipBufferSize > stats->zipBufferSize)
+			stats->zipBufferSize = zipBufferSize;
+	}
+}
+
+/**********************************************************************************************************************/
+static void getUnpackItemPath(PackReader packReader, uint64_t itemIndex, char* itemPath)
+{
+	assert(packReader != NULL);
+	assert(itemPath != NULL);
+
+	uint8_t pathSize = packReader->itemHeaders[itemIndex].pathSize;
+	memcpy(itemPath, getPackItemPath(packReader, itemIndex), pathSize);
+	itemPath[pathSize] = 0;
+
+	for (uint8_t i = 0; i < pathSize; i++)
+	{
+		if (itemPath[i] == '/' || itemPath[i] == '\\')
+			itemPath[i] = '-';
+	}
+}
+static void removePackItemFiles(PackReader packReader, const bool* createdFiles)
+{
+	assert(packReader != NULL);
+	assert(createdFiles != NULL);
+
+	char itemPath[UINT8_MAX + 1];
+	for (uint64_t i = 0; i < packReader->itemCount; i++)
+	{
+		if (!createdFiles[i])
+			continue;
+		getUnpackItemPath(packReader, i, itemPath);
+		remove(itemPath);
+	}
+}
+
+#if __linux__
+// NOTE: Kernel copies the file data directly, so it never passes through the user space buffers.
+static uint32_t copyPackFileRange(PackFile file, uint64_t offset, int itemFile, uint32_t size)
+{
+	uint32_t copiedSize = 0;
+	bool useSendfile = false;
+
+	while (copiedSize < size)
+	{
+		ssize_t result;
+		if (!useSendfile)
 		{
-			int progress = (int)(((float)(i + 1) / (float)itemCount) * 100.0f);
-			const char* spacing;
-			if (progress < 10)
-				spacing = "  ";
-			else if (progress < 100)
-				spacing = " ";
-			else
-				spacing = "";
-			printf("[%s%d%%] Unpacking file %s ", spacing, progress, item->path);
-			fflush(stdout);
+			#ifdef __NR_copy_file_range
+			int64_t fileOffset = (int64_t)(offset + copiedSize);
+			result = syscall(__NR_copy_file_range, file, &fileOffset, itemFile, NULL, (size_t)(size - copiedSize), 0);
+			#else
+			result = -1; errno = ENOSYS;
+			#endif
+			
+			// NOTE: Older kernels can't copy across the different file systems.
+			if (result < 0 && errno != EINTR)
+			{
+				useSendfile = true;
+				continue;
+			}
+		}
+		else
+		{
+			off_t fileOffset = (off_t)(offset + copiedSize);
+			result = sendfile(itemFile, file, &fileOffset, (size_t)(size - copiedSize));
 		}
 
-		uint32_t dataSize = getPackItemDataSize(packReader, i);
-		uint8_t* data = malloc(dataSize);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			break;
+		copiedSize += (uint32_t)result;
+	}
+
+	return copiedSize;
+}
+#endif
+
+static PackResult unpackPackItem(PackUnpacker* unpacker, uint64_t itemIndex)
+{
+	assert(unpacker != NULL);
+
+	PackUnpackData* unpackData = unpacker->unpackData;
+	PackReader packReader = unpackData->packReader;
+	const PackItemHeader* header = &packReader->itemHeaders[itemIndex];
+	uint32_t dataSize = header->dataSize;
+
+	char itemPath[UINT8_MAX + 1];
+	getUnpackItemPath(packReader, itemIndex, itemPath);
+
+	FILE* itemFile = openFile(itemPath, "wb");
+	if (!itemFile)
+		return FAILED_TO_OPEN_FILE_PACK_RESULT;
+	unpackData->createdFiles[itemIndex] = true;
+
+	uint32_t copiedSize = 0;
+	#if __linux__
+	if (header->zipSize == 0 && !header->isSolid && dataSize > 0)
+		copiedSize = copyPackFileRange(packReader->file, header->dataOffset, fileno(itemFile), dataSize);
+	#endif
+
+	if (copiedSize == dataSize)
+	{
+		closeFile(itemFile);
+		return SUCCESS_PACK_RESULT;
+	}
+
+	if (dataSize > unpacker->dataSize)
+	{
+		uint8_t* data = realloc(unpacker->data, dataSize);
 		if (!data)
 		{
-			removePackItemFiles(i, items);
-			destroyPackReader(packReader);
+			closeFile(itemFile);
 			return FAILED_TO_ALLOCATE_PACK_RESULT;
 		}
 
-		packResult = readPackItemData(packReader, i, data, 0);
-		if (packResult != SUCCESS_PACK_RESULT)
-		{
-			free(data);
-			removePackItemFiles(i, items);
-			destroyPackReader(packReader);
-			return packResult;
-		}
+		unpacker->data = data;
+		unpacker->dataSize = dataSize;
+	}
+
+	uint32_t writeSize = dataSize - copiedSize;
+	PackResult packResult = SUCCESS_PACK_RESULT;
+
+	if (copiedSize > 0)
+	{
+		if (!readPackFile(packReader->file, header->dataOffset + copiedSize, unpacker->data, writeSize))
+			packResult = FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+	else
+	{
+		packResult = readPackItemData(packReader, itemIndex, unpacker->data, unpacker->threadIndex);
+	}
+
+	if (packResult == SUCCESS_PACK_RESULT && fwrite(unpacker->data, sizeof(uint8_t), writeSize, itemFile) != writeSize)
+		packResult = FAILED_TO_OPEN_FILE_PACK_RESULT;
+
+	closeFile(itemFile);
+	return packResult;
+}
+static PackResult verifyPackItem(PackUnpacker* unpacker, uint64_t itemIndex)
+{
+	assert(unpacker != NULL);
+
+	PackReader packReader = unpacker->unpackData->packReader;
+	uint32_t dataSize = packReader->itemHeaders[itemIndex].dataSize;
+
+	if (dataSize > unpacker->dataSize)
+	{
+		uint8_t* data = realloc(unpacker->data, dataSize);
+		if (!data)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+		unpacker->data = data;
+		unpacker->dataSize = dataSize;
+	}
+
+	return readPackItemData(packReader, itemIndex, unpacker->data, unpacker->threadIndex);
+}
+static void printUnpackItemProgress(PackUnpackData* unpackData, uint64_t itemIndex)
+{
+	assert(unpackData != NULL);
+
+	PackReader packReader = unpackData->packReader;
+	const PackItemHeader* header = &packReader->itemHeaders[itemIndex];
+
+	int progress = (int)(((float)unpackData->unpackedCount / (float)packReader->itemCount) * 100.0f);
+	const char* spacing;
+	if (progress < 10)
+		spacing = "  ";
+	else if (progress < 100)
+		spacing = " ";
+	else
+		spacing = "";
+
+	uint32_t zipItemSize = 0;
+	if (!header->isReference && !header->isSolid)
+		zipItemSize = header->zipSize > 0 ? header->zipSize : header->dataSize;
+
+	printf("[%s%d%%] %s %s (%u/%u bytes)\n", spacing, progress, unpackData->isVerifying ? 
+		"Verifying item" : "Unpacking file", getPackItemPath(packReader, itemIndex), zipItemSize, header->dataSize);
+	fflush(stdout);
+}
+static PACK_THREAD_RESULT unpackPackItems(void* argument)
+{
+	assert(argument != NULL);
 
-		uint8_t pathSize = item->header.pathSize;
-		char itemPath[UINT8_MAX + 1];
-		memcpy(itemPath, item->path, pathSize);
-		itemPath[pathSize] = 0;
+	PackUnpacker* unpacker = (PackUnpacker*)argument;
+	PackUnpackData* unpackData = unpacker->unpackData;
+	PackReader packReader = unpackData->packReader;
+	uint64_t itemCount = packReader->itemCount;
+
+	while (!atomicLoad32(&unpackData->isAborted))
+	{
+		// NOTE: Items are claimed one by one, so a large item doesn't stall the other threads.
+		uint64_t itemIndex = (uint64_t)atomicFetchAdd64(&unpackData->itemIndex, 1);
+		if (itemIndex >= itemCount)
+			break;
+
+		PackResult packResult = unpackData->isVerifying ? 
+			verifyPackItem(unpacker, itemIndex) : unpackPackItem(unpacker, itemIndex);
+		const PackItemHeader* header = &packReader->itemHeaders[itemIndex];
 
-		for (uint8_t j = 0; j < pathSize; j++)
+		lockPackMutex(&unpackData->mutex);
+		if (packResult == SUCCESS_PACK_RESULT)
 		{
-			if (itemPath[j] == '/' || itemPath[j] == '\\')
-				itemPath[j] = '-';
+			unpackData->unpackedCount++;
+			unpackData->rawFileSize += header->dataSize;
+			unpackData->fileOffset += sizeof(PackItemHeader) + header->pathSize;
+			if (!header->isReference && !header->isSolid)
+				unpackData->fileOffset += header->zipSize > 0 ? header->zipSize : header->dataSize;
+			if (unpackData->printProgress)
+				printUnpackItemProgress(unpackData, itemIndex);
 		}
-
-		FILE* itemFile = openFile(itemPath, "wb");
-		if (!itemFile)
+		else if (unpackData->isVerifying && (packResult == FAILED_TO_DECOMPRESS_PACK_RESULT || 
+			packResult == BAD_ITEM_CHECKSUM_PACK_RESULT))
 		{
-			free(data);
-			removePackItemFiles(i, items);
-			destroyPackReader(packReader);
-			return FAILED_TO_OPEN_FILE_PACK_RESULT;
+			// NOTE: Verification continues after the damaged item, so all of them are reported.
+			unpackData->unpackedCount++;
+			unpackData->damagedCount++;
+			if (unpackData->packResult == SUCCESS_PACK_RESULT)
+				unpackData->packResult = packResult;
+			if (unpackData->printProgress)
+			{
+				printf("Damaged item %s. (%s)\n", getPackItemPath(packReader, itemIndex), packResultToString(packResult));
+				fflush(stdout);
+			}
 		}
+		else if (!atomicLoad32(&unpackData->isAborted))
+		{
+			unpackData->packResult = packResult;
+			atomicStore32(&unpackData->isAborted, 1);
+		}
+		unlockPackMutex(&unpackData->mutex);
+	}
 
-		size_t result = fwrite(data, sizeof(uint8_t), dataSize, itemFile);
-		free(data);
-		closeFile(itemFile);
+	PACK_THREAD_RETURN;
+}
+
+static PackResult processPackItems(const char* filePath, uint32_t threadCount, bool printProgress, bool isVerifying)
+{
+	assert(filePath != NULL);
+	assert(threadCount > 0);
+
+	PackReader packReader;
+	PackResult packResult = createFilePackReader(filePath, 0, false, threadCount, &packReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
 
-		if (result != dataSize)
+	setPackReaderAccess(packReader, SEQUENTIAL_PACK_ACCESS);
+	if (isVerifying)
+		setPackReaderVerify(packReader, true);
+
+	PackUnpackData unpackData;
+	memset(&unpackData, 0, sizeof(PackUnpackData));
+	unpackData.packReader = packReader;
+	unpackData.fileOffset = sizeof(PackHeader) + packReader->hashSlotCount * sizeof(PackHashSlot);
+	unpackData.packResult = SUCCESS_PACK_RESULT;
+	unpackData.printProgress = printProgress;
+	unpackData.isVerifying = isVerifying;
+
+	if (packReader->itemChecksums)
+		unpackData.fileOffset += packReader->itemCount * sizeof(uint32_t);
+
+	if (!isVerifying)
+	{
+		unpackData.createdFiles = calloc(packReader->itemCount, sizeof(bool));
+		if (!unpackData.createdFiles)
 		{
-			removePackItemFiles(i, items);
 			destroyPackReader(packReader);
-			return FAILED_TO_OPEN_FILE_PACK_RESULT;
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
 		}
+	}
 
-		if (printProgress)
-		{
-			rawFileSize += dataSize;
-			fileOffset += sizeof(PackItemHeader) + pathSize;
-			
-			if (item->header.isReference)
-			{
-				printf("(0/%u bytes)\n", dataSize);
-			}
-			else
-			{
-				uint32_t zipItemSize = item->header.zipSize > 0 ?
-					item->header.zipSize : item->header.dataSize;
-				fileOffset += zipItemSize;
-				printf("(%u/%u bytes)\n", zipItemSize, dataSize);
-			}
-			
-			fflush(stdout);
-		}
+	PackUnpacker* unpackers = calloc(threadCount, sizeof(PackUnpacker));
+	PackThread* threads = malloc(threadCount * sizeof(PackThread));
+	if (!unpackers || !threads || !initPackMutex(&unpackData.mutex))
+	{
+		free(threads); free(unpackers);
+		free(unpackData.createdFiles);
+		destroyPackReader(packReader);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		unpackers[i].unpackData = &unpackData;
+		unpackers[i].threadIndex = i;
+	}
+
+	// NOTE: Calling thread unpacks items too, using the first reader thread slot.
+	uint32_t startedCount = 1;
+	for (; startedCount < threadCount; startedCount++)
+	{
+		if (createPackThread(unpackPackItems, &unpackers[startedCount], &threads[startedCount]))
+			continue;
+
+		// NOTE: Already started threads store their results under the mutex too.
+		lockPackMutex(&unpackData.mutex);
+		if (unpackData.packResult == SUCCESS_PACK_RESULT)
+			unpackData.packResult = FAILED_TO_ALLOCATE_PACK_RESULT;
+		atomicStore32(&unpackData.isAborted, 1);
+		unlockPackMutex(&unpackData.mutex);
+		break;
+	}
+
+	unpackPackItems(&unpackers[0]);
+	for (uint32_t i = 1; i < startedCount; i++)
+		joinPackThread(threads[i]);
+
+	for (uint32_t i = 0; i < threadCount; i++)
+		free(unpackers[i].data);
+	free(threads); free(unpackers);
+	destroyPackMutex(&unpackData.mutex);
+
+	if (unpackData.packResult != SUCCESS_PACK_RESULT && (!isVerifying || atomicLoad32(&unpackData.isAborted)))
+	{
+		if (!isVerifying)
+			removePackItemFiles(packReader, unpackData.createdFiles);
+		free(unpackData.createdFiles);
+		destroyPackReader(packReader);
+		return unpackData.packResult;
 	}
 
+	free(unpackData.createdFiles);
 	destroyPackReader(packReader);
 
+	if (isVerifying)
+	{
+		if (printProgress)
+		{
+			printf("Verified %llu items, %llu damaged.\n", (long long unsigned int)unpackData.unpackedCount,
+				(long long unsigned int)unpackData.damagedCount);
+		}
+		return unpackData.packResult;
+	}
 	if (printProgress)
 	{
 		int compression = (int)((1.0 -
-			(double)(fileOffset) / (double)rawFileSize) * 100.0);
+			(double)(unpackData.fileOffset) / (double)unpackData.rawFileSize) * 100.0);
 		printf("Unpacked %llu files. (%llu/%llu bytes, %d%% saved)\n",
-			(long long unsigned int)itemCount,
-			(long long unsigned int)fileOffset,
-			(long long unsigned int)rawFileSize,
+			(long long unsigned int)unpackData.unpackedCount,
+			(long long unsigned int)unpackData.fileOffset,
+			(long long unsigned int)unpackData.rawFileSize,
 			compression);
 	}
 
 	return SUCCESS_PACK_RESULT;
+}
+PackResult unpackFiles(const char* filePath, uint32_t threadCount, bool printProgress)
+{
+	assert(filePath != NULL);
+	assert(threadCount > 0);
+	return processPackItems(filePath, threadCount, printProgress, false);
+}
+PackResult verifyPackFiles(const char* filePath, uint32_t threadCount, bool printProgress)
+{
+	assert(filePath != NULL);
+	assert(threadCount > 0);
+	return processPackItems(filePath, threadCount, printProgress, true);
 }
\ No newline at end of file
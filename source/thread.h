@@ -0,0 +1,183 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Internal Pack library thread functions.
+ * @details Minimal portable wrappers over the Win32 and POSIX threads, C99 has no standard threads.
+ */
+
+#pragma once
+#include <stdbool.h>
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+typedef HANDLE PackThread;
+typedef SRWLOCK PackMutex;
+typedef CONDITION_VARIABLE PackCondition;
+typedef LPTHREAD_START_ROUTINE OnPackThread;
+
+#define PACK_THREAD_RESULT DWORD WINAPI
+#define PACK_THREAD_RETURN return 0
+#else
+#include <pthread.h>
+
+typedef pthread_t PackThread;
+typedef pthread_mutex_t PackMutex;
+typedef pthread_cond_t PackCondition;
+typedef void*(*OnPackThread)(void*);
+
+#define PACK_THREAD_RESULT void*
+#define PACK_THREAD_RETURN return NULL
+#endif
+
+#if _MSC_VER
+#define PACK_THREAD_LOCAL __declspec(thread)
+#else
+#define PACK_THREAD_LOCAL __thread
+#endif
+
+/**
+ * @brief Creates and starts a new thread.
+ * @return True on success, otherwise false.
+ *
+ * @param onThread thread function, declared with the PACK_THREAD_RESULT return type
+ * @param[in] argument thread function argument
+ * @param[out] thread pointer to the thread handle
+ */
+inline static bool createPackThread(OnPackThread onThread, void* argument, PackThread* thread)
+{
+	#if _WIN32
+	*thread = CreateThread(NULL, 0, onThread, argument, 0, NULL);
+	return *thread != NULL;
+	#else
+	return pthread_create(thread, NULL, onThread, argument) == 0;
+	#endif
+}
+/**
+ * @brief Waits for the thread function to return and destroys the thread.
+ * @param thread target thread handle
+ */
+inline static void joinPackThread(PackThread thread)
+{
+	#if _WIN32
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+	#else
+	pthread_join(thread, NULL);
+	#endif
+}
+
+/**
+ * @brief Initializes a new mutex.
+ * @return True on success, otherwise false.
+ * @param[out] mutex pointer to the mutex
+ */
+inline static bool initPackMutex(PackMutex* mutex)
+{
+	#if _WIN32
+	InitializeSRWLock(mutex);
+	return true;
+	#else
+	return pthread_mutex_init(mutex, NULL) == 0;
+	#endif
+}
+/**
+ * @brief Destroys the mutex.
+ * @param[in] mutex pointer to the mutex
+ */
+inline static void destroyPackMutex(PackMutex* mutex)
+{
+	#if !_WIN32
+	pthread_mutex_destroy(mutex);
+	#endif
+}
+/**
+ * @brief Locks the mutex, blocks until it's available.
+ * @param[in] mutex pointer to the mutex
+ */
+inline static void lockPackMutex(PackMutex* mutex)
+{
+	#if _WIN32
+	AcquireSRWLockExclusive(mutex);
+	#else
+	pthread_mutex_lock(mutex);
+	#endif
+}
+/**
+ * @brief Unlocks the mutex.
+ * @param[in] mutex pointer to the mutex
+ */
+inline static void unlockPackMutex(PackMutex* mutex)
+{
+	#if _WIN32
+	ReleaseSRWLockExclusive(mutex);
+	#else
+	pthread_mutex_unlock(mutex);
+	#endif
+}
+
+/**
+ * @brief Initializes a new condition variable.
+ * @return True on success, otherwise false.
+ * @param[out] condition pointer to the condition variable
+ */
+inline static bool initPackCondition(PackCondition* condition)
+{
+	#if _WIN32
+	InitializeConditionVariable(condition);
+	return true;
+	#else
+	return pthread_cond_init(condition, NULL) == 0;
+	#endif
+}
+/**
+ * @brief Destroys the condition variable.
+ * @param[in] condition pointer to the condition variable
+ */
+inline static void destroyPackCondition(PackCondition* condition)
+{
+	#if !_WIN32
+	pthread_cond_destroy(condition);
+	#endif
+}
+/**
+ * @brief Unlocks the mutex and waits for the condition variable signal, then locks the mutex again.
+ * @note Wakeups can be spurious, so the waited condition should be checked in a loop.
+ *
+ * @param[in] condition pointer to the condition variable
+ * @param[in] mutex pointer to the locked mutex
+ */
+inline static void waitPackCondition(PackCondition* condition, PackMutex* mutex)
+{
+	#if _WIN32
+	SleepConditionVariableSRW(condition, mutex, INFINITE, 0);
+	#else
+	pthread_cond_wait(condition, mutex);
+	#endif
+}
+/**
+ * @brief Wakes up all threads waiting for the condition variable.
+ * @param[in] condition pointer to the condition variable
+ */
+inline static void broadcastPackCondition(PackCondition* condition)
+{
+	#if _WIN32
+	WakeAllConditionVariable(condition);
+	#else
+	pthread_cond_broadcast(condition);
+	#endif
+}
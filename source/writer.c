@@ -13,394 +13,2055 @@
 // limitations under the License.
 
 #include "pack/writer.h"
+#include "pack/reader.h"
 #include "mpio/file.h"
+#include "thread.h"
 
 #include "zstd.h"
+#include "zdict.h"
 #include "lz4hc.h"
+#define LZ4F_STATIC_LINKING_ONLY
+#include "lz4frame.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
 
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#define MAX_ZSTD_WINDOW_LOG 23
+#define MAX_DICTIONARY_SIZE 112640
+#define MAX_DICTIONARY_SAMPLE_SIZE 131072
+#define MAX_DICTIONARY_SAMPLES_SIZE (MAX_DICTIONARY_SIZE * 100)
+#define MIN_DICTIONARY_SIZE 1024
+#define MAX_RETAINED_DATA_SIZE 268435456
+
 typedef struct FileItemPath
 {
 	const char* filePath;
 	const char* itemPath;
+	const uint8_t* itemData; // NOTE: Memory item data, used if there is no file path and base item.
+	uint64_t baseItemIndex;
+	uint32_t itemDataSize;
 } FileItemPath;
 
-typedef struct CompressorData
+typedef struct PackItemSlot
 {
 	uint8_t* itemData;
 	uint8_t* zipData;
-	PackItemHeader* itemHeaders;
-	void* zipContext;
-	FILE* itemFile;
+	size_t itemDataSize;
+	size_t zipDataSize;
+	uint64_t dataHash[2];
+	PackItemHeader header;
+	PackResult result;
+	uint32_t checksum;
+	bool isReady;
+} PackItemSlot;
+
+typedef struct PackDataSlot
+{
+	uint8_t* data; // NOTE: Copy of the written item data, or NULL if retained data size limit is reached.
+	uint64_t dataHash[2];
+	uint64_t itemIndex;
+} PackDataSlot;
+
+typedef struct PackBlockData
+{
+	uint8_t* data;
+	uint8_t* zipData;
+	uint64_t* itemIndices;
+	const char* itemPath;
+	size_t zipDataSize;
+	uint32_t dataSize;
+	uint32_t directorySize;
+	uint32_t itemCount;
+	uint32_t itemCapacity;
 	bool preferSpeed;
+} PackBlockData;
+
+typedef struct PackWriteData PackWriteData;
+
+typedef struct CompressorData
+{
+	PackWriteData* writeData;
+	ZSTD_CCtx* zstdContext;
+	LZ4F_cctx* lz4Context;
+	FILE* baseFile;
 } CompressorData;
 
-static void destroyCompressorData(CompressorData* compressor)
+struct PackWriteData
+{
+	const FileItemPath* pathPairs;
+	const uint64_t* itemOrder;
+	PackReader baseReader;
+	const char* basePackPath;
+	ZSTD_CDict* zstdDictionary;
+	LZ4F_CDict* lz4Dictionary;
+	OnPackItemZip onItemZip;
+	void* argument;
+	PackItemSlot* itemSlots;
+	CompressorData* compressors;
+	CompressorData blockCompressor;
+	PackThread* threads;
+	uint64_t itemCount;
+	uint64_t nextItemIndex;
+	uint64_t writtenItemCount;
+	PackMutex mutex;
+	PackCondition itemCondition;
+	PackCondition slotCondition;
+	float zipThreshold;
+	uint32_t solidThreshold;
+	uint32_t slotCount;
+	uint32_t threadCount;
+	bool preferSpeed;
+	bool useChecksums;
+	bool isAborted;
+};
+
+static bool createCompressorContext(CompressorData* compressor, bool preferSpeed)
 {
-	if (compressor->itemFile)
-		closeFile(compressor->itemFile);
-	if (compressor->preferSpeed)
-		free(compressor->zipContext);
-	else ZSTD_freeCCtx(compressor->zipContext);
+	assert(compressor != NULL);
+
+	// NOTE: Compression contexts are created on the first use, as most packs use only one algorithm.
+	if (preferSpeed)
+	{
+		if (compressor->lz4Context)
+			return true;
+
+		LZ4F_cctx* lz4Context;
+		if (LZ4F_isError(LZ4F_createCompressionContext(&lz4Context, LZ4F_VERSION)))
+			return false;
+		compressor->lz4Context = lz4Context;
+		return true;
+	}
+
+	if (compressor->zstdContext)
+		return true;
+
+	ZSTD_CCtx* zstdContext = ZSTD_createCCtx();
+	if (!zstdContext)
+		return false;
+	compressor->zstdContext = zstdContext;
 
-	free(compressor->itemHeaders);
-	free(compressor->zipData);
-	free(compressor->itemData);
+	ZSTD_CCtx_setParameter(zstdContext, ZSTD_c_compressionLevel, ZSTD_maxCLevel());
+	// NOTE: Limits decompression window, so large items can be streamed with a bounded memory.
+	ZSTD_CCtx_setParameter(zstdContext, ZSTD_c_windowLog, MAX_ZSTD_WINDOW_LOG);
+
+	const ZSTD_CDict* zstdDictionary = compressor->writeData->zstdDictionary;
+	if (zstdDictionary)
+	{
+		// NOTE: There is only one dictionary per archive, so we don't need dictionary ID in each frame.
+		ZSTD_CCtx_setParameter(zstdContext, ZSTD_c_dictIDFlag, 0);
+		if (ZSTD_isError(ZSTD_CCtx_refCDict(zstdContext, zstdDictionary)))
+			return false;
+	}
+	return true;
+}
+static void destroyCompressorData(CompressorData* compressor)
+{
+	assert(compressor != NULL);
+	if (compressor->baseFile)
+		closeFile(compressor->baseFile);
+	if (compressor->lz4Context)
+		LZ4F_freeCompressionContext(compressor->lz4Context);
+	ZSTD_freeCCtx(compressor->zstdContext);
 }
 
 /**********************************************************************************************************************/
-static PackResult writePackItems(FILE* packFile, uint64_t itemCount,
-	const FileItemPath* pathPairs, float zipThreshold, bool preferSpeed,
-	bool printProgress, OnPackFile onPackFile, void* argument)
+static uint64_t mixPackDataHash(uint64_t hash)
 {
-	assert(packFile != NULL);
-	assert(itemCount > 0);
-	assert(pathPairs != NULL);
-
-	CompressorData compressor;
-	memset(&compressor, 0, sizeof(CompressorData));
-	compressor.preferSpeed = preferSpeed;
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDull;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ull;
+	return hash ^ (hash >> 33);
+}
+static void hashPackItemData(const uint8_t* data, uint32_t dataSize, uint64_t dataHash[2])
+{
+	assert(data != NULL);
+	assert(dataHash != NULL);
 
-	uint32_t bufferSize = 1;
-	compressor.itemData = malloc(sizeof(uint8_t));
-	if (!compressor.itemData)
-		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	// NOTE: Hash is used only while packing to find duplicate items, it's not stored in the Pack file.
+	const uint64_t multiplier0 = 0x9E3779B97F4A7C15ull, multiplier1 = 0xC2B2AE3D27D4EB4Full;
+	uint64_t hash0 = (dataSize + 1) * multiplier0, hash1 = (dataSize + 1) * multiplier1;
+	uint64_t value0, value1; uint32_t offset = 0;
 
-	compressor.zipData = malloc(sizeof(uint8_t));
-	if (!compressor.zipData)
+	while (dataSize - offset >= sizeof(uint64_t) * 2)
 	{
-		destroyCompressorData(&compressor);
-		return FAILED_TO_ALLOCATE_PACK_RESULT;
+		memcpy(&value0, data + offset, sizeof(uint64_t));
+		memcpy(&value1, data + offset + sizeof(uint64_t), sizeof(uint64_t));
+		hash0 = (hash0 ^ value0) * multiplier0;
+		hash1 = (hash1 ^ value1) * multiplier1;
+		hash0 ^= hash0 >> 29;
+		hash1 ^= hash1 >> 32;
+		offset += sizeof(uint64_t) * 2;
 	}
 
-	compressor.itemHeaders = malloc(itemCount * sizeof(PackItemHeader));
-	if (!compressor.itemHeaders)
+	value0 = value1 = 0;
+	uint32_t tailSize = dataSize - offset;
+	if (tailSize > sizeof(uint64_t))
 	{
-		destroyCompressorData(&compressor);
-		return FAILED_TO_ALLOCATE_PACK_RESULT;
+		memcpy(&value0, data + offset, sizeof(uint64_t));
+		memcpy(&value1, data + offset + sizeof(uint64_t), tailSize - sizeof(uint64_t));
+	}
+	else
+	{
+		memcpy(&value0, data + offset, tailSize);
 	}
 
+	hash0 = (hash0 ^ value0) * multiplier0;
+	hash1 = (hash1 ^ value1) * multiplier1;
+	dataHash[0] = mixPackDataHash(hash0 ^ (hash1 >> 31));
+	dataHash[1] = mixPackDataHash(hash1 ^ (hash0 << 27));
+}
+
+static void getLz4Preferences(uint32_t dataSize, LZ4F_preferences_t* preferences)
+{
+	assert(preferences != NULL);
+	memset(preferences, 0, sizeof(LZ4F_preferences_t));
+
+	// NOTE: Linked small blocks allow to decompress item data in the streaming mode.
+	preferences->frameInfo.blockSizeID = LZ4F_max64KB;
+	preferences->frameInfo.blockMode = LZ4F_blockLinked;
+	preferences->frameInfo.contentSize = dataSize;
+	preferences->compressionLevel = LZ4HC_CLEVEL_MAX;
+}
+static size_t compressLz4Frame(LZ4F_cctx* lz4Context, const LZ4F_CDict* lz4Dictionary, 
+	const uint8_t* data, uint32_t dataSize, uint8_t* zipData, size_t zipCapacity)
+{
+	assert(lz4Context != NULL);
+	assert(data != NULL);
+	assert(zipData != NULL);
+
+	LZ4F_preferences_t preferences;
+	getLz4Preferences(dataSize, &preferences);
+
+	size_t headerSize = LZ4F_compressBegin_usingCDict(lz4Context, 
+		zipData, zipCapacity, lz4Dictionary, &preferences);
+	if (LZ4F_isError(headerSize))
+		return headerSize;
+
+	size_t blockSize = LZ4F_compressUpdate(lz4Context, zipData + headerSize, 
+		zipCapacity - headerSize, data, dataSize, NULL);
+	if (LZ4F_isError(blockSize))
+		return blockSize;
+
+	size_t endSize = LZ4F_compressEnd(lz4Context, zipData + headerSize + blockSize, 
+		zipCapacity - (headerSize + blockSize), NULL);
+	if (LZ4F_isError(endSize))
+		return endSize;
+	return headerSize + blockSize + endSize;
+}
+
+static size_t getPackFrameBound(bool preferSpeed, uint32_t dataSize)
+{
 	if (preferSpeed)
-		compressor.zipContext = malloc(LZ4_sizeofStateHC());
-	else compressor.zipContext = ZSTD_createCCtx();
+	{
+		// NOTE: LZ4 frame compression requires the worst case destination buffer size.
+		LZ4F_preferences_t preferences;
+		getLz4Preferences(dataSize, &preferences);
+		return LZ4F_compressFrameBound(dataSize, &preferences);
+	}
+	return ZSTD_compressBound(dataSize);
+}
+static bool compressPackFrame(const CompressorData* compressor, bool preferSpeed, const uint8_t* data,
+	uint32_t dataSize, uint8_t* zipData, size_t zipCapacity, size_t* zipSize)
+{
+	assert(compressor != NULL);
+	assert(data != NULL);
+	assert(zipData != NULL);
+	assert(zipSize != NULL);
 
-	if (!compressor.zipContext)
+	size_t result;
+	if (preferSpeed)
 	{
-		destroyCompressorData(&compressor);
-		return FAILED_TO_ALLOCATE_PACK_RESULT;
+		result = compressLz4Frame(compressor->lz4Context, 
+			compressor->writeData->lz4Dictionary, data, dataSize, zipData, zipCapacity);
+		if (LZ4F_isError(result))
+			return false;
+	}
+	else
+	{
+		result = ZSTD_compress2(compressor->zstdContext, zipData, zipCapacity, data, dataSize);
+		if (ZSTD_isError(result))
+			return false;
 	}
 
-	uint32_t maxFileSize = preferSpeed ? LZ4_MAX_INPUT_SIZE : UINT32_MAX;
-	uint64_t rawFileSize = 0; uint64_t fileOffset = sizeof(PackHeader);
+	*zipSize = result;
+	return true;
+}
+static bool compressPackItemData(const CompressorData* compressor, bool preferSpeed, PackItemSlot* itemSlot,
+	uint32_t dataSize, size_t zipCapacity, uint32_t maxZipSize, uint32_t* zipSize)
+{
+	assert(compressor != NULL);
+	assert(itemSlot != NULL);
+	assert(zipSize != NULL);
 
-	for (uint64_t i = 0; i < itemCount; i++)
+	size_t frameZipSize;
+	if (dataSize <= PACK_FRAME_SIZE)
 	{
-		const char* itemPath = pathPairs[i].itemPath;
-		if (printProgress)
+		if (!preferSpeed && zipCapacity > maxZipSize)
+			zipCapacity = maxZipSize; // NOTE: ZSTD stops early if data is not compressible enough.
+
+		if (!compressPackFrame(compressor, preferSpeed, itemSlot->itemData, 
+			dataSize, itemSlot->zipData, zipCapacity, &frameZipSize) || frameZipSize > maxZipSize)
 		{
-			int progress = (int)(((float)(i + 1) / (float)itemCount) * 100.0f);
-			const char* spacing;
-			if (progress < 10)
-				spacing = "  ";
-			else if (progress < 100)
-				spacing = " ";
-			else
-				spacing = "";
-			printf("[%s%d%%] Packing file %s ", spacing, progress, itemPath);
-			fflush(stdout);
+			return false;
 		}
 
-		if (onPackFile)
-			onPackFile(i, argument);
+		*zipSize = (uint32_t)frameZipSize;
+		return true;
+	}
 
-		size_t pathSize = strlen(itemPath);
-		if (pathSize > UINT8_MAX)
+	// NOTE: Large items are split into independent frames to allow random access reads.
+	uint32_t frameCount = getPackFrameCount(dataSize);
+	uint32_t* frameSizes = (uint32_t*)itemSlot->zipData;
+	size_t zipOffset = frameCount * sizeof(uint32_t);
+
+	for (uint32_t i = 0; i < frameCount; i++)
+	{
+		uint32_t dataOffset = i * PACK_FRAME_SIZE;
+		uint32_t frameSize = dataSize - dataOffset < PACK_FRAME_SIZE ? dataSize - dataOffset : PACK_FRAME_SIZE;
+
+		if (!compressPackFrame(compressor, preferSpeed, itemSlot->itemData + dataOffset, frameSize, 
+			itemSlot->zipData + zipOffset, zipCapacity - zipOffset, &frameZipSize))
 		{
-			destroyCompressorData(&compressor);
-			return BAD_DATA_SIZE_PACK_RESULT;
+			return false;
 		}
 
-		compressor.itemFile = openFile(pathPairs[i].filePath, "rb");
-		if (!compressor.itemFile)
-		{
-			destroyCompressorData(&compressor);
+		frameSizes[i] = (uint32_t)frameZipSize;
+		zipOffset += frameZipSize;
+		if (zipOffset > maxZipSize)
+			return false;
+	}
+
+	*zipSize = (uint32_t)zipOffset;
+	return true;
+}
+static bool reservePackItemSlot(PackItemSlot* itemSlot, size_t itemDataSize, size_t zipDataSize)
+{
+	assert(itemSlot != NULL);
+
+	if (itemDataSize > itemSlot->itemDataSize)
+	{
+		uint8_t* newBuffer = realloc(itemSlot->itemData, itemDataSize);
+		if (!newBuffer)
+			return false;
+		itemSlot->itemData = newBuffer;
+		itemSlot->itemDataSize = itemDataSize;
+	}
+	if (zipDataSize > itemSlot->zipDataSize)
+	{
+		uint8_t* newBuffer = realloc(itemSlot->zipData, zipDataSize);
+		if (!newBuffer)
+			return false;
+		itemSlot->zipData = newBuffer;
+		itemSlot->zipDataSize = zipDataSize;
+	}
+	return true;
+}
+static PackResult compressPackItem(CompressorData* compressor, 
+	const FileItemPath* pathPair, float zipThreshold, PackItemSlot* itemSlot)
+{
+	assert(compressor != NULL);
+	assert(pathPair != NULL);
+	assert(itemSlot != NULL);
+
+	FILE* itemFile = NULL; uint64_t fileSize = pathPair->itemDataSize;
+	if (pathPair->filePath)
+	{
+		itemFile = openFile(pathPair->filePath, "rb");
+		if (!itemFile)
 			return FAILED_TO_OPEN_FILE_PACK_RESULT;
-		}
 
-		if (seekFile(compressor.itemFile, 0, SEEK_END) != 0)
+		if (seekFile(itemFile, 0, SEEK_END) != 0)
 		{
-			destroyCompressorData(&compressor);
+			closeFile(itemFile);
 			return FAILED_TO_SEEK_FILE_PACK_RESULT;
 		}
 
-		uint64_t fileSize = (uint64_t)tellFile(compressor.itemFile);
-		if (fileSize > maxFileSize)
+		fileSize = (uint64_t)tellFile(itemFile);
+		if (fileSize > UINT32_MAX)
 		{
-			destroyCompressorData(&compressor);
+			closeFile(itemFile);
 			return BAD_DATA_SIZE_PACK_RESULT;
 		}
+	}
+
+	PackItemHeader header;
+	memset(&header, 0, sizeof(PackItemHeader));
+	header.dataSize = (uint32_t)fileSize;
+	header.pathSize = (uint8_t)strlen(pathPair->itemPath);
+
+	if (header.dataSize == 0)
+	{
+		if (itemFile)
+			closeFile(itemFile);
+		itemSlot->header = header;
+		itemSlot->checksum = 0;
+		return SUCCESS_PACK_RESULT;
+	}
+
+	const PackWriteData* writeData = compressor->writeData;
+	PackZipType zipType = DEFAULT_PACK_ZIP_TYPE;
+	if (writeData->onItemZip)
+		zipType = writeData->onItemZip(pathPair->itemPath, header.dataSize, writeData->argument);
 
-		uint64_t sameDataOffset = UINT64_MAX;
-		uint8_t* zipItemData = NULL; uint32_t zipItemSize = 0;
+	bool preferSpeed = zipType == DEFAULT_PACK_ZIP_TYPE ? writeData->preferSpeed : zipType == LZ4_PACK_ZIP_TYPE;
+	bool isCompressed = zipType != NONE_PACK_ZIP_TYPE;
+	bool isSolid = isCompressed && header.dataSize <= writeData->solidThreshold;
 
-		PackItemHeader header;
-		header.dataSize = (uint32_t)fileSize;
-		header.pathSize = (uint8_t)pathSize;
+	size_t zipCapacity;
+	if (isSolid)
+	{
+		zipCapacity = 0; // NOTE: Solid items are compressed later by the writer, together with the block.
+	}
+	else if (!isCompressed)
+	{
+		zipCapacity = 0;
+	}
+	else if (header.dataSize > PACK_FRAME_SIZE)
+	{
+		uint32_t frameCount = getPackFrameCount(header.dataSize);
+		zipCapacity = frameCount * (sizeof(uint32_t) + getPackFrameBound(preferSpeed, PACK_FRAME_SIZE));
+	}
+	else
+	{
+		zipCapacity = getPackFrameBound(preferSpeed, header.dataSize);
+	}
 
-		if (header.dataSize > 0)
+	if (isCompressed && !isSolid && !createCompressorContext(compressor, preferSpeed))
+	{
+		if (itemFile)
+			closeFile(itemFile);
+		return preferSpeed ? FAILED_TO_ALLOCATE_PACK_RESULT : FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+	}
+
+	if (!reservePackItemSlot(itemSlot, header.dataSize, zipCapacity))
+	{
+		if (itemFile)
+			closeFile(itemFile);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	if (itemFile)
+	{
+		if (seekFile(itemFile, 0, SEEK_SET) != 0)
 		{
-			if (header.dataSize > bufferSize)
-			{
-				uint8_t* newBuffer = realloc(compressor.itemData, header.dataSize);
-				if (!newBuffer)
-				{
-					destroyCompressorData(&compressor);
-					return FAILED_TO_ALLOCATE_PACK_RESULT;
-				}
-				compressor.itemData = newBuffer;
+			closeFile(itemFile);
+			return FAILED_TO_SEEK_FILE_PACK_RESULT;
+		}
 
-				newBuffer = realloc(compressor.zipData, header.dataSize);
-				if (!newBuffer)
-				{
-					destroyCompressorData(&compressor);
-					return FAILED_TO_ALLOCATE_PACK_RESULT;
-				}
-				compressor.zipData = newBuffer;
-			}
+		size_t result = fread(itemSlot->itemData, sizeof(uint8_t), header.dataSize, itemFile);
+		closeFile(itemFile);
 
-			if (seekFile(compressor.itemFile, 0, SEEK_SET) != 0)
-			{
-				destroyCompressorData(&compressor);
-				return FAILED_TO_SEEK_FILE_PACK_RESULT;
-			}
+		if (result != header.dataSize)
+			return FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+	else
+	{
+		// NOTE: Memory item is copied, so it can be compressed and compared the same way as the file data.
+		memcpy(itemSlot->itemData, pathPair->itemData, header.dataSize);
+	}
 
-			size_t result = fread(compressor.itemData, sizeof(uint8_t), header.dataSize, compressor.itemFile);
-			closeFile(compressor.itemFile); compressor.itemFile = NULL;
+	itemSlot->checksum = writeData->useChecksums ? computePackChecksum(itemSlot->itemData, header.dataSize, 0) : 0;
 
-			if (result != header.dataSize)
-			{
-				destroyCompressorData(&compressor);
-				return FAILED_TO_READ_FILE_PACK_RESULT;
-			}
+	if (isSolid)
+	{
+		header.preferSpeed = preferSpeed ? 1 : 0;
+		header.isSolid = 1;
+		itemSlot->header = header;
+		return SUCCESS_PACK_RESULT;
+	}
 
-			uint32_t maxZipSize = header.dataSize - (uint32_t)((double)header.dataSize * zipThreshold);
+	uint32_t maxZipSize = header.dataSize - (uint32_t)((double)header.dataSize * zipThreshold);
+	if (isCompressed && compressPackItemData(compressor, preferSpeed, 
+		itemSlot, header.dataSize, zipCapacity, maxZipSize, &header.zipSize))
+	{
+		header.preferSpeed = preferSpeed ? 1 : 0;
+		hashPackItemData(itemSlot->zipData, header.zipSize, itemSlot->dataHash);
+	}
+	else
+	{
+		header.zipSize = 0;
+		hashPackItemData(itemSlot->itemData, header.dataSize, itemSlot->dataHash);
+	}
 
-			uint32_t isError;
-			if (preferSpeed)
-			{
-				header.zipSize = (uint32_t)LZ4_compress_HC_extStateHC(compressor.zipContext, 
-					(const char*)compressor.itemData, (char*)compressor.zipData, 
-					(int)header.dataSize, (int)maxZipSize, LZ4HC_CLEVEL_MAX);
-				isError = header.zipSize == 0;
-			}
-			else
-			{
-				result = ZSTD_compressCCtx((ZSTD_CCtx*)compressor.zipContext, compressor.zipData, 
-					maxZipSize, compressor.itemData, header.dataSize, ZSTD_maxCLevel());
-				header.zipSize = (uint32_t)result; isError = ZSTD_isError(result);
-			}
+	itemSlot->header = header;
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult copyPackItem(CompressorData* compressor, 
+	const FileItemPath* pathPair, PackItemSlot* itemSlot)
+{
+	assert(compressor != NULL);
+	assert(pathPair != NULL);
+	assert(itemSlot != NULL);
 
-			if (isError)
-			{
-				header.zipSize = 0;
-				zipItemData = compressor.zipData;
-				zipItemSize = header.dataSize;
-			}
-			else
-			{
-				zipItemData = compressor.itemData;
-				zipItemSize = header.zipSize;
-			}
-		
-			for (size_t j = 0; j < i; j++)
-			{
-				PackItemHeader* otherHeader = &compressor.itemHeaders[j];
-				if (otherHeader->zipSize != header.zipSize || otherHeader->dataSize != header.dataSize)
-					continue;
-
-				if (seekFile(packFile, otherHeader->dataOffset, SEEK_SET) != 0)
-				{
-					destroyCompressorData(&compressor);
-					return FAILED_TO_SEEK_FILE_PACK_RESULT;
-				}
-
-				if (fread(zipItemData, sizeof(uint8_t), zipItemSize, packFile) != zipItemSize)
-				{
-					destroyCompressorData(&compressor);
-					return FAILED_TO_READ_FILE_PACK_RESULT;
-				}
-				if (memcmp(compressor.itemData, compressor.zipData, zipItemSize) == 0)
-				{
-					sameDataOffset = otherHeader->dataOffset;
-					break;
-				}
-			}
-		}
+	PackReader baseReader = compressor->writeData->baseReader;
+	uint64_t baseItemIndex = pathPair->baseItemIndex;
+	assert(baseReader != NULL);
 
-		if (seekFile(packFile, fileOffset, SEEK_SET) != 0)
-		{
-			destroyCompressorData(&compressor);
-			return FAILED_TO_SEEK_FILE_PACK_RESULT;
-		}
-		
-		if (sameDataOffset == UINT64_MAX)
-		{
-			header.dataOffset = (uint64_t)(fileOffset +
-				sizeof(PackItemHeader) + pathSize);
-			header.isReference = 0;
-		}
-		else
-		{
-			header.dataOffset = sameDataOffset;
-			header.isReference = 1;
-		}
+	PackItemHeader header;
+	memset(&header, 0, sizeof(PackItemHeader));
+	header.zipSize = getPackItemZipSize(baseReader, baseItemIndex);
+	header.dataSize = getPackItemDataSize(baseReader, baseItemIndex);
+	header.preferSpeed = header.zipSize > 0 && isPackItemPreferSpeed(baseReader, baseItemIndex) ? 1 : 0;
+	header.pathSize = (uint8_t)strlen(pathPair->itemPath);
 
-		compressor.itemHeaders[i] = header;
-		if (fwrite(&header, sizeof(PackItemHeader), 1, packFile) != 1)
-		{
-			destroyCompressorData(&compressor);
-			return FAILED_TO_WRITE_FILE_PACK_RESULT;
-		}
+	if (header.dataSize == 0)
+	{
+		itemSlot->header = header;
+		itemSlot->checksum = 0;
+		return SUCCESS_PACK_RESULT;
+	}
 
-		if (fwrite(itemPath, sizeof(char), header.pathSize, packFile) != header.pathSize)
-		{
-			destroyCompressorData(&compressor);
-			return FAILED_TO_WRITE_FILE_PACK_RESULT;
-		}
+	// NOTE: Checksum is not computed if it's not written to the pack.
+	itemSlot->checksum = 0;
+	bool hasChecksum = !compressor->writeData->useChecksums || 
+		getPackItemChecksum(baseReader, baseItemIndex, &itemSlot->checksum);
 
-		fileOffset += sizeof(PackItemHeader) + header.pathSize;
+	if (isPackItemSolid(baseReader, baseItemIndex))
+	{
+		// NOTE: Base pack blocks are decompressed, so unchanged solid items are regrouped with the new ones.
+		if (!reservePackItemSlot(itemSlot, header.dataSize, 0))
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
 
-		if (header.dataSize > 0 && sameDataOffset == UINT64_MAX)
-		{
-			zipItemData = header.zipSize > 0 ? compressor.zipData : compressor.itemData;
-			if (fwrite(zipItemData, sizeof(uint8_t), zipItemSize, packFile) != zipItemSize)
-			{
-				destroyCompressorData(&compressor);
-				return FAILED_TO_WRITE_FILE_PACK_RESULT;
-			}
+		PackResult packResult = readPackItemDataConcurrent(baseReader, baseItemIndex, itemSlot->itemData);
+		if (packResult != SUCCESS_PACK_RESULT)
+			return packResult;
 
-			fileOffset += zipItemSize;
+		if (!hasChecksum)
+			itemSlot->checksum = computePackChecksum(itemSlot->itemData, header.dataSize, 0);
 
-			if (printProgress)
-			{
-				rawFileSize += header.dataSize;
-				printf("(%u/%u bytes)\n", zipItemSize, header.dataSize);
-				fflush(stdout);
-			}
-		}
-		else
-		{
-			if (printProgress)
-			{
-				rawFileSize += header.dataSize;
-				printf("(0/%u bytes)\n", header.dataSize);
-				fflush(stdout);
-			}
-		}
+		header.preferSpeed = isPackItemPreferSpeed(baseReader, baseItemIndex) ? 1 : 0;
+		header.isSolid = 1;
+		itemSlot->header = header;
+		return SUCCESS_PACK_RESULT;
 	}
 
-	destroyCompressorData(&compressor);
+	// NOTE: Items from the older packs are decompressed to get the checksum.
+	uint32_t zipItemSize = header.zipSize > 0 ? header.zipSize : header.dataSize;
+	uint32_t itemDataSize = header.zipSize > 0 && hasChecksum ? 0 : header.dataSize;
+	if (!reservePackItemSlot(itemSlot, itemDataSize, header.zipSize))
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
 
-	if (printProgress)
+	if (!compressor->baseFile)
 	{
-		int compression = (int)((1.0 -
-			(double)(fileOffset) / (double)rawFileSize) * 100.0);
-		printf("Packed %llu files. (%llu/%llu bytes, %d%% saved)\n",
-			(long long unsigned int)itemCount,
-			(long long unsigned int)fileOffset,
-			(long long unsigned int)rawFileSize,
-			compression);
+		// NOTE: Each thread has its own base pack file, so reads don't share the file position.
+		compressor->baseFile = openFile(compressor->writeData->basePackPath, "rb");
+		if (!compressor->baseFile)
+			return FAILED_TO_OPEN_FILE_PACK_RESULT;
+	}
+
+	uint64_t fileOffset = getPackItemFileOffset(baseReader, baseItemIndex);
+	if (seekFile(compressor->baseFile, (int64_t)fileOffset, SEEK_SET) != 0)
+		return FAILED_TO_SEEK_FILE_PACK_RESULT;
+
+	uint8_t* zipItemData = header.zipSize > 0 ? itemSlot->zipData : itemSlot->itemData;
+	if (fread(zipItemData, sizeof(uint8_t), zipItemSize, compressor->baseFile) != zipItemSize)
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+
+	if (!hasChecksum)
+	{
+		if (header.zipSize > 0)
+		{
+			PackResult packResult = readPackItemDataConcurrent(baseReader, baseItemIndex, itemSlot->itemData);
+			if (packResult != SUCCESS_PACK_RESULT)
+				return packResult;
+		}
+		itemSlot->checksum = computePackChecksum(itemSlot->itemData, header.dataSize, 0);
 	}
 
+	hashPackItemData(zipItemData, zipItemSize, itemSlot->dataHash);
+	itemSlot->header = header;
 	return SUCCESS_PACK_RESULT;
 }
-static int comparePackPathPairs(const void* _a, const void* _b)
+static PackResult preparePackItem(CompressorData* compressor, 
+	const FileItemPath* pathPair, float zipThreshold, PackItemSlot* itemSlot)
 {
-	// NOTE: a and b should not be NULL!
-	// Skipping here assertions for debug build speed.
-	FileItemPath* a = (FileItemPath*)_a;
-	FileItemPath* b = (FileItemPath*)_b;
-	uint8_t al = (uint8_t)strlen(a->itemPath);
-	uint8_t bl = (uint8_t)strlen(b->itemPath);
-	int difference = al - bl;
-	if (difference != 0)
-		return difference;
-	return memcmp(a->itemPath, b->itemPath, al);
+	// NOTE: Base pack items are copied as is, without recompression.
+	if (pathPair->baseItemIndex == UINT64_MAX)
+		return compressPackItem(compressor, pathPair, zipThreshold, itemSlot);
+	return copyPackItem(compressor, pathPair, itemSlot);
 }
 
 /**********************************************************************************************************************/
-PackResult packFiles(const char* filePath, uint64_t fileCount, const char** fileItemPaths, uint32_t dataVersion, 
-	float zipThreshold, bool preferSpeed, bool printProgress, OnPackFile onPackFile, void* argument)
+static PACK_THREAD_RESULT compressPackItems(void* argument)
 {
-	assert(filePath != NULL);
-	assert(fileCount > 0);
-	assert(fileItemPaths != NULL);
+	assert(argument != NULL);
+	CompressorData* compressor = (CompressorData*)argument;
+	PackWriteData* writeData = compressor->writeData;
 
-	FileItemPath* pathPairs = malloc(fileCount * sizeof(FileItemPath));
-	if (!pathPairs)
-		return FAILED_TO_ALLOCATE_PACK_RESULT;
-
-	uint64_t itemCount = 0;
-	for (uint64_t i = 0; i < fileCount; i++)
+	while (true)
 	{
-		bool alreadyAdded = false;
-		for (uint64_t j = 0; j < itemCount; j++)
+		lockPackMutex(&writeData->mutex);
+		uint64_t itemIndex = writeData->nextItemIndex;
+		if (writeData->isAborted || itemIndex >= writeData->itemCount)
 		{
-			if (i != j && strcmp(fileItemPaths[i * 2], pathPairs[j].filePath) == 0)
-				alreadyAdded = true;
+			unlockPackMutex(&writeData->mutex);
+			break;
 		}
+		writeData->nextItemIndex++;
 
-		if (!alreadyAdded)
-		{
-			FileItemPath pathPair;
-			pathPair.filePath = fileItemPaths[i * 2];
-			pathPair.itemPath = fileItemPaths[i * 2 + 1];
-			pathPairs[itemCount++] = pathPair;
-		}
-	}
+		// NOTE: Waiting for the writer to free the slot, it limits the amount of compressed items in memory.
+		while (itemIndex >= writeData->writtenItemCount + writeData->slotCount && !writeData->isAborted)
+			waitPackCondition(&writeData->slotCondition, &writeData->mutex);
 
-	qsort(pathPairs, itemCount, sizeof(FileItemPath), comparePackPathPairs);
+		bool isAborted = writeData->isAborted;
+		unlockPackMutex(&writeData->mutex);
 
-	FILE* packFile = openFile(filePath, "w+b");
-	if (!packFile)
-	{
-		free(pathPairs);
-		return FAILED_TO_CREATE_FILE_PACK_RESULT;
-	}
+		if (isAborted)
+			break;
 
-	PackHeader header;
-	header.magic = PACK_HEADER_MAGIC;
-	header.versionMajor = PACK_VERSION_MAJOR;
-	header.versionMinor = PACK_VERSION_MINOR;
-	header.versionPatch = PACK_VERSION_PATCH;
-	header.isBigEndian = !PACK_LITTLE_ENDIAN;
-	header.itemCount = itemCount;
-	header.dataVersion = dataVersion;
-	header.preferSpeed = preferSpeed ? 1 : 0;
-	header._reserved = 0;
+		PackItemSlot* itemSlot = &writeData->itemSlots[itemIndex % writeData->slotCount];
+		PackResult packResult = preparePackItem(compressor, &writeData->pathPairs[
+			writeData->itemOrder[itemIndex]], writeData->zipThreshold, itemSlot);
 
-	size_t writeResult = fwrite(&header, sizeof(PackHeader), 1, packFile);
-	if (writeResult != 1)
-	{
-		free(pathPairs); closeFile(packFile); remove(filePath);
-		return FAILED_TO_WRITE_FILE_PACK_RESULT;
+		lockPackMutex(&writeData->mutex);
+		itemSlot->result = packResult;
+		itemSlot->isReady = true;
+		broadcastPackCondition(&writeData->itemCondition);
+		unlockPackMutex(&writeData->mutex);
 	}
 
-	PackResult packResult = writePackItems(packFile, itemCount, pathPairs, 
-		zipThreshold, preferSpeed, printProgress, onPackFile, argument);
+	PACK_THREAD_RETURN;
+}
 
-	free(pathPairs);
-	closeFile(packFile);
+static PackResult writePackItem(FILE* packFile, PackItemHeader* itemHeaders, PackDataSlot* dataSlots, 
+	uint64_t dataSlotCount, uint64_t itemIndex, PackItemSlot* itemSlot, 
+	uint64_t* retainedDataSize, uint64_t* fileOffset)
+{
+	assert(packFile != NULL);
+	assert(itemHeaders != NULL);
+	assert(dataSlots != NULL);
+	assert(itemSlot != NULL);
+	assert(retainedDataSize != NULL);
+	assert(fileOffset != NULL);
 
-	if (packResult != SUCCESS_PACK_RESULT)
+	PackItemHeader header = itemSlot->header;
+	uint64_t sameDataOffset = UINT64_MAX;
+	const uint8_t* zipItemData = header.zipSize > 0 ? itemSlot->zipData : itemSlot->itemData;
+	uint32_t zipItemSize = header.zipSize > 0 ? header.zipSize : header.dataSize;
+
+	if (header.dataSize > 0)
 	{
-		remove(filePath);
-		return packResult;
-	}
+		const uint64_t* dataHash = itemSlot->dataHash;
+		uint64_t slotIndex = dataHash[0] & (dataSlotCount - 1);
 
-	return SUCCESS_PACK_RESULT;
-}
\ No newline at end of file
+		while (dataSlots[slotIndex].itemIndex != 0)
+		{
+			const PackDataSlot* dataSlot = &dataSlots[slotIndex];
+			const PackItemHeader* otherHeader = &itemHeaders[dataSlot->itemIndex - 1];
+
+			if (dataSlot->data && dataSlot->dataHash[0] == dataHash[0] && dataSlot->dataHash[1] == dataHash[1] && 
+				otherHeader->zipSize == header.zipSize && otherHeader->dataSize == header.dataSize && 
+				otherHeader->preferSpeed == header.preferSpeed && memcmp(dataSlot->data, zipItemData, zipItemSize) == 0)
+			{
+				sameDataOffset = otherHeader->dataOffset;
+				break;
+			}
+			slotIndex = (slotIndex + 1) & (dataSlotCount - 1);
+		}
+
+		if (sameDataOffset == UINT64_MAX)
+		{
+			// NOTE: Retained data is limited, later items are still written, but not deduplicated against.
+			uint8_t* data = NULL;
+			if (*retainedDataSize + zipItemSize <= MAX_RETAINED_DATA_SIZE)
+			{
+				data = malloc(zipItemSize);
+				if (!data)
+					return FAILED_TO_ALLOCATE_PACK_RESULT;
+				memcpy(data, zipItemData, zipItemSize);
+				*retainedDataSize += zipItemSize;
+			}
+
+			PackDataSlot* dataSlot = &dataSlots[slotIndex];
+			dataSlot->data = data;
+			dataSlot->dataHash[0] = dataHash[0];
+			dataSlot->dataHash[1] = dataHash[1];
+			dataSlot->itemIndex = itemIndex + 1;
+		}
+	}
+
+	if (seekFile(packFile, *fileOffset, SEEK_SET) != 0)
+		return FAILED_TO_SEEK_FILE_PACK_RESULT;
+
+	if (sameDataOffset == UINT64_MAX)
+	{
+		header.dataOffset = *fileOffset;
+		header.isReference = 0;
+	}
+	else
+	{
+		header.dataOffset = sameDataOffset;
+		header.isReference = 1;
+	}
+
+	itemHeaders[itemIndex] = header;
+	itemSlot->header = header;
+
+	if (header.dataSize > 0 && sameDataOffset == UINT64_MAX)
+	{
+		if (fwrite(zipItemData, sizeof(uint8_t), zipItemSize, packFile) != zipItemSize)
+			return FAILED_TO_WRITE_FILE_PACK_RESULT;
+		*fileOffset += zipItemSize;
+	}
+
+	return SUCCESS_PACK_RESULT;
+}
+static uint32_t getPackItemDirectorySize(const char* itemPath)
+{
+	assert(itemPath != NULL);
+	const char* separator = strrchr(itemPath, '/');
+	return separator ? (uint32_t)(separator - itemPath) : 0;
+}
+static PackResult flushPackBlock(FILE* packFile, PackItemHeader* itemHeaders, CompressorData* compressor, 
+	PackBlockData* blockData, float zipThreshold, uint64_t* fileOffset)
+{
+	assert(packFile != NULL);
+	assert(itemHeaders != NULL);
+	assert(compressor != NULL);
+	assert(blockData != NULL);
+	assert(fileOffset != NULL);
+
+	if (blockData->itemCount == 0)
+		return SUCCESS_PACK_RESULT;
+
+	bool preferSpeed = blockData->preferSpeed;
+	if (!createCompressorContext(compressor, preferSpeed))
+		return preferSpeed ? FAILED_TO_ALLOCATE_PACK_RESULT : FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+
+	size_t zipCapacity = getPackFrameBound(preferSpeed, blockData->dataSize);
+	if (zipCapacity > blockData->zipDataSize)
+	{
+		uint8_t* newBuffer = realloc(blockData->zipData, zipCapacity);
+		if (!newBuffer)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+		blockData->zipData = newBuffer;
+		blockData->zipDataSize = zipCapacity;
+	}
+
+	uint32_t dataSize = blockData->dataSize;
+	uint32_t maxZipSize = dataSize - (uint32_t)((double)dataSize * zipThreshold);
+	if (!preferSpeed && zipCapacity > maxZipSize)
+		zipCapacity = maxZipSize; // NOTE: ZSTD stops early if data is not compressible enough.
+
+	size_t zipSize;
+	bool isCompressed = compressPackFrame(compressor, preferSpeed, blockData->data, 
+		dataSize, blockData->zipData, zipCapacity, &zipSize) && zipSize <= maxZipSize;
+
+	if (seekFile(packFile, *fileOffset, SEEK_SET) != 0)
+		return FAILED_TO_SEEK_FILE_PACK_RESULT;
+
+	uint64_t blockOffset = *fileOffset;
+	if (isCompressed)
+	{
+		PackBlockHeader blockHeader;
+		blockHeader.zipSize = (uint32_t)zipSize;
+		blockHeader.dataSize = dataSize;
+
+		if (fwrite(&blockHeader, sizeof(PackBlockHeader), 1, packFile) != 1 ||
+			fwrite(blockData->zipData, sizeof(uint8_t), zipSize, packFile) != zipSize)
+		{
+			return FAILED_TO_WRITE_FILE_PACK_RESULT;
+		}
+		*fileOffset += sizeof(PackBlockHeader) + zipSize;
+	}
+	else
+	{
+		if (fwrite(blockData->data, sizeof(uint8_t), dataSize, packFile) != dataSize)
+			return FAILED_TO_WRITE_FILE_PACK_RESULT;
+		*fileOffset += dataSize;
+	}
+
+	// NOTE: Intra-block item offsets are stored in the item headers, instead of a separate offset table.
+	uint32_t itemOffset = 0;
+	for (uint32_t i = 0; i < blockData->itemCount; i++)
+	{
+		PackItemHeader* header = &itemHeaders[blockData->itemIndices[i]];
+		if (isCompressed)
+		{
+			header->dataOffset = blockOffset;
+			header->zipSize = itemOffset;
+			header->preferSpeed = preferSpeed ? 1 : 0;
+			header->isSolid = 1;
+		}
+		else
+		{
+			header->dataOffset = blockOffset + itemOffset;
+			header->zipSize = 0;
+			header->preferSpeed = 0;
+			header->isSolid = 0;
+		}
+		itemOffset += header->dataSize;
+	}
+
+	blockData->dataSize = 0;
+	blockData->itemCount = 0;
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult addPackBlockItem(FILE* packFile, PackItemHeader* itemHeaders, CompressorData* compressor, 
+	PackBlockData* blockData, const char* itemPath, uint64_t itemIndex, const PackItemSlot* itemSlot, 
+	float zipThreshold, uint64_t* fileOffset)
+{
+	assert(blockData != NULL);
+	assert(itemPath != NULL);
+	assert(itemSlot != NULL);
+
+	const PackItemHeader* header = &itemSlot->header;
+	assert(header->isSolid);
+	assert(header->dataSize <= PACK_BLOCK_SIZE);
+
+	// NOTE: Only items from the same directory are grouped, as they are usually loaded together.
+	uint32_t directorySize = getPackItemDirectorySize(itemPath);
+	if (blockData->itemCount > 0 && (blockData->preferSpeed != header->preferSpeed || 
+		blockData->dataSize + header->dataSize > PACK_BLOCK_SIZE || blockData->directorySize != directorySize || 
+		memcmp(blockData->itemPath, itemPath, directorySize) != 0))
+	{
+		PackResult packResult = flushPackBlock(packFile, itemHeaders, 
+			compressor, blockData, zipThreshold, fileOffset);
+		if (packResult != SUCCESS_PACK_RESULT)
+			return packResult;
+	}
+
+	if (!blockData->data)
+	{
+		blockData->data = malloc(PACK_BLOCK_SIZE);
+		if (!blockData->data)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	if (blockData->itemCount == blockData->itemCapacity)
+	{
+		uint32_t itemCapacity = blockData->itemCapacity > 0 ? blockData->itemCapacity * 2 : 16;
+		uint64_t* newIndices = realloc(blockData->itemIndices, itemCapacity * sizeof(uint64_t));
+		if (!newIndices)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+		blockData->itemIndices = newIndices;
+		blockData->itemCapacity = itemCapacity;
+	}
+
+	if (blockData->itemCount == 0)
+	{
+		blockData->itemPath = itemPath;
+		blockData->directorySize = directorySize;
+		blockData->preferSpeed = header->preferSpeed;
+	}
+
+	memcpy(blockData->data + blockData->dataSize, itemSlot->itemData, header->dataSize);
+	blockData->dataSize += header->dataSize;
+	blockData->itemIndices[blockData->itemCount++] = itemIndex;
+	itemHeaders[itemIndex] = *header;
+	return SUCCESS_PACK_RESULT;
+}
+
+static void printPackItemProgress(uint64_t itemIndex, uint64_t itemCount, 
+	const FileItemPath* pathPair, const PackItemHeader* header)
+{
+	assert(pathPair != NULL);
+	assert(header != NULL);
+
+	int progress = (int)(((float)(itemIndex + 1) / (float)itemCount) * 100.0f);
+	const char* spacing;
+	if (progress < 10)
+		spacing = "  ";
+	else if (progress < 100)
+		spacing = " ";
+	else
+		spacing = "";
+
+	uint32_t zipItemSize = header->zipSize > 0 ? header->zipSize : header->dataSize;
+	if (header->isReference || header->isSolid || header->dataSize == 0)
+		zipItemSize = 0;
+
+	const char* action = pathPair->baseItemIndex != UINT64_MAX ? 
+		"Copying item" : pathPair->filePath ? "Packing file" : "Packing item";
+	printf("[%s%d%%] %s %s (%u/%u bytes)\n", spacing, progress, 
+		action, pathPair->itemPath, zipItemSize, header->dataSize);
+	fflush(stdout);
+}
+
+static void stopPackWriteThreads(PackWriteData* writeData)
+{
+	assert(writeData != NULL);
+
+	lockPackMutex(&writeData->mutex);
+	writeData->isAborted = true;
+	broadcastPackCondition(&writeData->slotCondition);
+	unlockPackMutex(&writeData->mutex);
+
+	for (uint32_t i = 0; i < writeData->threadCount; i++)
+		joinPackThread(writeData->threads[i]);
+	free(writeData->threads);
+	writeData->threads = NULL;
+
+	destroyPackCondition(&writeData->slotCondition);
+	destroyPackCondition(&writeData->itemCondition);
+	destroyPackMutex(&writeData->mutex);
+}
+static PackResult startPackWriteThreads(PackWriteData* writeData)
+{
+	assert(writeData != NULL);
+
+	uint32_t threadCount = writeData->threadCount;
+	if (!initPackMutex(&writeData->mutex))
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	if (!initPackCondition(&writeData->itemCondition))
+	{
+		destroyPackMutex(&writeData->mutex);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	if (!initPackCondition(&writeData->slotCondition))
+	{
+		destroyPackCondition(&writeData->itemCondition);
+		destroyPackMutex(&writeData->mutex);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	writeData->threads = malloc(threadCount * sizeof(PackThread));
+	if (!writeData->threads)
+	{
+		destroyPackCondition(&writeData->slotCondition);
+		destroyPackCondition(&writeData->itemCondition);
+		destroyPackMutex(&writeData->mutex);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		if (createPackThread(compressPackItems, &writeData->compressors[i], &writeData->threads[i]))
+			continue;
+
+		// NOTE: Already running threads should finish before we free the shared data.
+		writeData->threadCount = i;
+		stopPackWriteThreads(writeData);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	return SUCCESS_PACK_RESULT;
+}
+static void destroyPackWriteData(PackWriteData* writeData, uint32_t compressorCount)
+{
+	assert(writeData != NULL);
+
+	if (writeData->itemSlots)
+	{
+		for (uint32_t i = 0; i < writeData->slotCount; i++)
+		{
+			free(writeData->itemSlots[i].zipData);
+			free(writeData->itemSlots[i].itemData);
+		}
+		free(writeData->itemSlots);
+	}
+	if (writeData->compressors)
+	{
+		for (uint32_t i = 0; i < compressorCount; i++)
+			destroyCompressorData(&writeData->compressors[i]);
+		free(writeData->compressors);
+	}
+	destroyCompressorData(&writeData->blockCompressor);
+
+	LZ4F_freeCDict(writeData->lz4Dictionary);
+	ZSTD_freeCDict(writeData->zstdDictionary);
+}
+static PackResult createPackWriteData(PackWriteData* writeData, uint64_t itemCount, const FileItemPath* pathPairs, 
+	const uint64_t* itemOrder, PackReader baseReader, const char* basePackPath, const uint8_t* dictionary, 
+	uint32_t dictionarySize, float zipThreshold, bool preferSpeed, bool useChecksums, uint32_t solidThreshold, 
+	uint32_t threadCount, OnPackItemZip onItemZip, void* argument)
+{
+	assert(writeData != NULL);
+	assert(itemCount > 0);
+	assert(pathPairs != NULL);
+	assert(itemOrder != NULL);
+	assert(threadCount > 0);
+
+	memset(writeData, 0, sizeof(PackWriteData));
+	writeData->pathPairs = pathPairs;
+	writeData->itemOrder = itemOrder;
+	writeData->baseReader = baseReader;
+	writeData->basePackPath = basePackPath;
+	writeData->itemCount = itemCount;
+	writeData->onItemZip = onItemZip;
+	writeData->argument = argument;
+	writeData->blockCompressor.writeData = writeData;
+	writeData->zipThreshold = zipThreshold;
+	writeData->solidThreshold = solidThreshold;
+	writeData->threadCount = threadCount;
+	writeData->preferSpeed = preferSpeed;
+	writeData->useChecksums = useChecksums;
+
+	// NOTE: Compression dictionary is read-only, so it's shared between all compression contexts.
+	if (dictionarySize > 0 && (preferSpeed || onItemZip))
+	{
+		writeData->lz4Dictionary = LZ4F_createCDict(dictionary, dictionarySize);
+		if (!writeData->lz4Dictionary)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	if (dictionarySize > 0 && (!preferSpeed || onItemZip))
+	{
+		writeData->zstdDictionary = ZSTD_createCDict(dictionary, dictionarySize, ZSTD_maxCLevel());
+		if (!writeData->zstdDictionary)
+		{
+			destroyPackWriteData(writeData, 0);
+			return FAILED_TO_CREATE_ZSTD_PACK_RESULT;
+		}
+	}
+
+	// NOTE: Two slots per thread, so workers can compress next items while the writer writes previous ones.
+	uint32_t slotCount = threadCount > 1 ? threadCount * 2 : 1;
+	PackItemSlot* itemSlots = calloc(slotCount, sizeof(PackItemSlot));
+	if (!itemSlots)
+	{
+		destroyPackWriteData(writeData, 0);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	writeData->itemSlots = itemSlots;
+	writeData->slotCount = slotCount;
+
+	CompressorData* compressors = calloc(threadCount, sizeof(CompressorData));
+	if (!compressors)
+	{
+		destroyPackWriteData(writeData, 0);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+	writeData->compressors = compressors;
+
+	for (uint32_t i = 0; i < threadCount; i++)
+		compressors[i].writeData = writeData;
+	return SUCCESS_PACK_RESULT;
+}
+
+/**********************************************************************************************************************/
+static PackResult writePackItems(FILE* packFile, uint64_t itemCount, const FileItemPath* pathPairs, 
+	const uint64_t* itemOrder, PackReader baseReader, const char* basePackPath, uint64_t indexSize, 
+	const uint8_t* dictionary, uint32_t dictionarySize, float zipThreshold, bool preferSpeed, bool useChecksums, 
+	uint32_t solidThreshold, uint32_t threadCount, bool printProgress, 
+	OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument)
+{
+	assert(packFile != NULL);
+	assert(itemCount > 0);
+	assert(pathPairs != NULL);
+	assert(itemOrder != NULL);
+	assert(threadCount > 0);
+
+	if (threadCount > itemCount)
+		threadCount = (uint32_t)itemCount;
+
+	// NOTE: Item checksums are stored right after the item headers, in the same allocation.
+	PackItemHeader* itemHeaders = malloc(itemCount * (sizeof(PackItemHeader) + sizeof(uint32_t)));
+	if (!itemHeaders)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	uint32_t* itemChecksums = (uint32_t*)(itemHeaders + itemCount);
+
+	// NOTE: Item data hash table is used to find the same item data without comparing all previous items.
+	uint64_t dataSlotCount = getPackHashSlotCount(itemCount);
+	PackDataSlot* dataSlots = calloc(dataSlotCount, sizeof(PackDataSlot));
+	if (!dataSlots)
+	{
+		free(itemHeaders);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	PackWriteData writeData;
+	PackResult packResult = createPackWriteData(&writeData, itemCount, pathPairs, itemOrder, baseReader, basePackPath, 
+		dictionary, dictionarySize, zipThreshold, preferSpeed, useChecksums, solidThreshold, threadCount, onItemZip, argument);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		free(dataSlots); free(itemHeaders);
+		return packResult;
+	}
+
+	bool isMultithreaded = threadCount > 1;
+	if (isMultithreaded)
+		packResult = startPackWriteThreads(&writeData);
+
+	PackBlockData blockData;
+	memset(&blockData, 0, sizeof(PackBlockData));
+
+	uint64_t retainedDataSize = 0;
+	uint64_t rawFileSize = 0; uint64_t fileOffset = sizeof(PackHeader) + indexSize + dictionarySize;
+	for (uint64_t i = 0; i < itemCount && packResult == SUCCESS_PACK_RESULT; i++)
+	{
+		uint64_t itemIndex = itemOrder[i];
+		if (onPackFile)
+			onPackFile(itemIndex, argument);
+
+		PackItemSlot* itemSlot = &writeData.itemSlots[i % writeData.slotCount];
+		if (isMultithreaded)
+		{
+			lockPackMutex(&writeData.mutex);
+			while (!itemSlot->isReady)
+				waitPackCondition(&writeData.itemCondition, &writeData.mutex);
+			unlockPackMutex(&writeData.mutex);
+		}
+		else
+		{
+			itemSlot->result = preparePackItem(&writeData.compressors[0], 
+				&pathPairs[itemIndex], zipThreshold, itemSlot);
+		}
+
+		// NOTE: Items are written in the item order, so output is the same for any thread count.
+		packResult = itemSlot->result;
+		if (packResult == SUCCESS_PACK_RESULT && itemSlot->header.isSolid)
+		{
+			packResult = addPackBlockItem(packFile, itemHeaders, &writeData.blockCompressor, &blockData, 
+				pathPairs[itemIndex].itemPath, itemIndex, itemSlot, zipThreshold, &fileOffset);
+		}
+		else if (packResult == SUCCESS_PACK_RESULT)
+		{
+			packResult = writePackItem(packFile, itemHeaders, dataSlots, 
+				dataSlotCount, itemIndex, itemSlot, &retainedDataSize, &fileOffset);
+		}
+		if (packResult != SUCCESS_PACK_RESULT)
+			break;
+		itemChecksums[itemIndex] = itemSlot->checksum;
+
+		if (printProgress)
+		{
+			rawFileSize += itemSlot->header.dataSize;
+			printPackItemProgress(i, itemCount, &pathPairs[itemIndex], &itemSlot->header);
+		}
+
+		if (isMultithreaded)
+		{
+			lockPackMutex(&writeData.mutex);
+			itemSlot->isReady = false;
+			writeData.writtenItemCount++;
+			broadcastPackCondition(&writeData.slotCondition);
+			unlockPackMutex(&writeData.mutex);
+		}
+	}
+
+	if (writeData.threads)
+		stopPackWriteThreads(&writeData);
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		packResult = flushPackBlock(packFile, itemHeaders, 
+			&writeData.blockCompressor, &blockData, zipThreshold, &fileOffset);
+	}
+
+	destroyPackWriteData(&writeData, threadCount);
+	free(blockData.itemIndices); free(blockData.zipData); free(blockData.data);
+	for (uint64_t i = 0; i < dataSlotCount; i++)
+		free(dataSlots[i].data);
+	free(dataSlots);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		free(itemHeaders);
+		return packResult;
+	}
+
+	if (seekFile(packFile, sizeof(PackHeader), SEEK_SET) != 0)
+	{
+		free(itemHeaders);
+		return FAILED_TO_SEEK_FILE_PACK_RESULT;
+	}
+	if (fwrite(itemHeaders, sizeof(PackItemHeader), itemCount, packFile) != itemCount)
+	{
+		free(itemHeaders);
+		return FAILED_TO_WRITE_FILE_PACK_RESULT;
+	}
+
+	uint64_t hashSlotCount = getPackHashSlotCount(itemCount);
+	PackHashSlot* hashSlots = calloc(hashSlotCount, sizeof(PackHashSlot));
+	if (!hashSlots)
+	{
+		free(itemHeaders);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		uint64_t pathHash = hashPackItemPath(pathPairs[i].itemPath, itemHeaders[i].pathSize);
+		uint64_t slotIndex = pathHash & (hashSlotCount - 1);
+		while (hashSlots[slotIndex].itemIndex != 0)
+			slotIndex = (slotIndex + 1) & (hashSlotCount - 1);
+
+		PackHashSlot* hashSlot = &hashSlots[slotIndex];
+		hashSlot->pathHash = (uint32_t)(pathHash >> 32);
+		hashSlot->itemIndex = (uint32_t)(i + 1);
+	}
+
+	size_t writeResult = fwrite(hashSlots, sizeof(PackHashSlot), hashSlotCount, packFile);
+	free(hashSlots);
+
+	if (writeResult != hashSlotCount || (useChecksums &&
+		fwrite(itemChecksums, sizeof(uint32_t), itemCount, packFile) != itemCount))
+	{
+		free(itemHeaders);
+		return FAILED_TO_WRITE_FILE_PACK_RESULT;
+	}
+
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		uint8_t pathSize = itemHeaders[i].pathSize;
+		if (fwrite(pathPairs[i].itemPath, sizeof(char), pathSize, packFile) != pathSize)
+		{
+			free(itemHeaders);
+			return FAILED_TO_WRITE_FILE_PACK_RESULT;
+		}
+	}
+
+	free(itemHeaders);
+
+	if (dictionarySize > 0 && fwrite(dictionary, sizeof(uint8_t), dictionarySize, packFile) != dictionarySize)
+		return FAILED_TO_WRITE_FILE_PACK_RESULT;
+
+	if (printProgress)
+	{
+		int compression = (int)((1.0 -
+			(double)(fileOffset) / (double)rawFileSize) * 100.0);
+		printf("Packed %llu files. (%llu/%llu bytes, %d%% saved)\n",
+			(long long unsigned int)itemCount,
+			(long long unsigned int)fileOffset,
+			(long long unsigned int)rawFileSize,
+			compression);
+	}
+
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult trainPackDictionary(uint64_t itemCount, const FileItemPath* pathPairs, 
+	uint8_t** dictionary, uint32_t* dictionarySize)
+{
+	assert(itemCount > 0);
+	assert(pathPairs != NULL);
+	assert(dictionary != NULL);
+	assert(dictionarySize != NULL);
+
+	*dictionary = NULL;
+	*dictionarySize = 0;
+
+	uint8_t* samples = malloc(MAX_DICTIONARY_SAMPLES_SIZE);
+	if (!samples)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	size_t* sampleSizes = malloc(itemCount * sizeof(size_t));
+	if (!sampleSizes)
+	{
+		free(samples);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	// NOTE: Only beginning of the large items is sampled, as dictionary helps mostly with the small ones.
+	size_t samplesSize = 0; uint32_t sampleCount = 0;
+	for (uint64_t i = 0; i < itemCount && samplesSize < MAX_DICTIONARY_SAMPLES_SIZE; i++)
+	{
+		const FileItemPath* pathPair = &pathPairs[i];
+		size_t sampleSize = MAX_DICTIONARY_SAMPLES_SIZE - samplesSize;
+		if (sampleSize > MAX_DICTIONARY_SAMPLE_SIZE)
+			sampleSize = MAX_DICTIONARY_SAMPLE_SIZE;
+
+		if (pathPair->filePath)
+		{
+			FILE* itemFile = openFile(pathPair->filePath, "rb");
+			if (!itemFile)
+			{
+				free(sampleSizes); free(samples);
+				return FAILED_TO_OPEN_FILE_PACK_RESULT;
+			}
+
+			sampleSize = fread(samples + samplesSize, sizeof(uint8_t), sampleSize, itemFile);
+			bool isError = ferror(itemFile) != 0;
+			closeFile(itemFile);
+
+			if (isError)
+			{
+				free(sampleSizes); free(samples);
+				return FAILED_TO_READ_FILE_PACK_RESULT;
+			}
+		}
+		else
+		{
+			if (sampleSize > pathPair->itemDataSize)
+				sampleSize = pathPair->itemDataSize;
+			if (sampleSize > 0)
+				memcpy(samples + samplesSize, pathPair->itemData, sampleSize);
+		}
+
+		if (sampleSize == 0)
+			continue;
+
+		sampleSizes[sampleCount++] = sampleSize;
+		samplesSize += sampleSize;
+	}
+
+	size_t dictionaryCapacity = samplesSize / 16;
+	if (dictionaryCapacity > MAX_DICTIONARY_SIZE)
+		dictionaryCapacity = MAX_DICTIONARY_SIZE;
+
+	if (dictionaryCapacity < MIN_DICTIONARY_SIZE)
+	{
+		free(sampleSizes); free(samples);
+		return SUCCESS_PACK_RESULT; // NOTE: Not enough data to train a useful dictionary.
+	}
+
+	uint8_t* dictionaryData = malloc(dictionaryCapacity);
+	if (!dictionaryData)
+	{
+		free(sampleSizes); free(samples);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	size_t result = ZDICT_trainFromBuffer(dictionaryData, dictionaryCapacity, samples, sampleSizes, sampleCount);
+	free(sampleSizes); free(samples);
+
+	if (ZDICT_isError(result))
+	{
+		free(dictionaryData);
+		return SUCCESS_PACK_RESULT; // NOTE: Samples are too small or too uniform, packing without a dictionary.
+	}
+
+	*dictionary = dictionaryData;
+	*dictionarySize = (uint32_t)result;
+	return SUCCESS_PACK_RESULT;
+}
+
+static int comparePackPathPairs(const void* _a, const void* _b)
+{
+	// NOTE: a and b should not be NULL!
+	// Skipping here assertions for debug build speed.
+	FileItemPath* a = (FileItemPath*)_a;
+	FileItemPath* b = (FileItemPath*)_b;
+	uint8_t al = (uint8_t)strlen(a->itemPath);
+	uint8_t bl = (uint8_t)strlen(b->itemPath);
+	int difference = al - bl;
+	if (difference != 0)
+		return difference;
+	return memcmp(a->itemPath, b->itemPath, al);
+}
+
+/**********************************************************************************************************************/
+static PackResult preparePackPathPairs(FileItemPath* pathPairs, 
+	uint64_t itemCount, bool useChecksums, uint64_t* indexSize)
+{
+	assert(pathPairs != NULL);
+	assert(indexSize != NULL);
+
+	qsort(pathPairs, itemCount, sizeof(FileItemPath), comparePackPathPairs);
+
+	if (itemCount >= UINT32_MAX)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	uint64_t size = itemCount * (sizeof(PackItemHeader) + (useChecksums ? sizeof(uint32_t) : 0)) +
+		getPackHashSlotCount(itemCount) * sizeof(PackHashSlot);
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		size_t pathSize = strlen(pathPairs[i].itemPath);
+		if (pathSize > UINT8_MAX)
+			return BAD_DATA_SIZE_PACK_RESULT;
+		size += pathSize;
+	}
+
+	*indexSize = size;
+	return SUCCESS_PACK_RESULT;
+}
+static int comparePackItemDirectories(const void* _a, const void* _b)
+{
+	// NOTE: a and b should not be NULL!
+	// Skipping here assertions for debug build speed.
+	const FileItemPath* a = *(const FileItemPath**)_a;
+	const FileItemPath* b = *(const FileItemPath**)_b;
+	uint32_t al = getPackItemDirectorySize(a->itemPath);
+	uint32_t bl = getPackItemDirectorySize(b->itemPath);
+	int difference = memcmp(a->itemPath, b->itemPath, al < bl ? al : bl);
+	if (difference != 0)
+		return difference;
+	if (al != bl)
+		return al < bl ? -1 : 1;
+	return strcmp(a->itemPath, b->itemPath);
+}
+static PackResult sortPackItemDirectories(const FileItemPath* pathPairs, uint64_t* order, uint64_t orderCount)
+{
+	assert(pathPairs != NULL);
+	assert(order != NULL);
+
+	const FileItemPath** sortPairs = malloc(orderCount * sizeof(FileItemPath*));
+	if (!sortPairs)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	for (uint64_t i = 0; i < orderCount; i++)
+		sortPairs[i] = &pathPairs[order[i]];
+	qsort(sortPairs, orderCount, sizeof(FileItemPath*), comparePackItemDirectories);
+	for (uint64_t i = 0; i < orderCount; i++)
+		order[i] = (uint64_t)(sortPairs[i] - pathPairs);
+
+	free(sortPairs);
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult createPackItemOrder(const FileItemPath* pathPairs, uint64_t itemCount, 
+	uint64_t traceCount, const char** traceItemPaths, bool groupDirectories, uint64_t** itemOrder)
+{
+	assert(pathPairs != NULL);
+	assert(traceCount == 0 || traceItemPaths != NULL);
+	assert(itemOrder != NULL);
+
+	uint64_t* order = malloc(itemCount * sizeof(uint64_t));
+	if (!order)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	bool* isOrdered = calloc(itemCount, sizeof(bool));
+	if (!isOrdered)
+	{
+		free(order);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	// NOTE: Item data is laid out in the first access order, so a traced load becomes a sequential sweep.
+	uint64_t orderCount = 0;
+	for (uint64_t i = 0; i < traceCount; i++)
+	{
+		if (strlen(traceItemPaths[i]) > UINT8_MAX)
+			continue;
+
+		FileItemPath tracePair;
+		tracePair.itemPath = traceItemPaths[i];
+		const FileItemPath* pathPair = bsearch(&tracePair, pathPairs, 
+			itemCount, sizeof(FileItemPath), comparePackPathPairs);
+		if (!pathPair)
+			continue; // NOTE: Trace may contain paths of the removed items.
+
+		uint64_t itemIndex = (uint64_t)(pathPair - pathPairs);
+		if (isOrdered[itemIndex])
+			continue;
+
+		isOrdered[itemIndex] = true;
+		order[orderCount++] = itemIndex;
+	}
+	uint64_t traceOrderCount = orderCount;
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		if (!isOrdered[i])
+			order[orderCount++] = i;
+	}
+	free(isOrdered);
+
+	// NOTE: Sibling items are placed next to each other, so they can share the same solid block.
+	if (groupDirectories && orderCount - traceOrderCount > 1)
+	{
+		PackResult packResult = sortPackItemDirectories(pathPairs, order + traceOrderCount, orderCount - traceOrderCount);
+		if (packResult != SUCCESS_PACK_RESULT)
+		{
+			free(order);
+			return packResult;
+		}
+	}
+
+	*itemOrder = order;
+	return SUCCESS_PACK_RESULT;
+}
+static PackResult writePackFile(const char* filePath, uint64_t itemCount, const FileItemPath* pathPairs, 
+	uint64_t traceCount, const char** traceItemPaths, PackReader baseReader, const char* basePackPath, 
+	uint64_t indexSize, uint32_t dataVersion, const uint8_t* dictionary, uint32_t dictionarySize, 
+	float zipThreshold, bool preferSpeed, bool useChecksums, uint32_t solidThreshold, uint32_t threadCount, 
+	bool printProgress, OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument)
+{
+	assert(filePath != NULL);
+	assert(pathPairs != NULL);
+
+	uint64_t* itemOrder;
+	PackResult packResult = createPackItemOrder(pathPairs, itemCount, 
+		traceCount, traceItemPaths, solidThreshold > 0, &itemOrder);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	FILE* packFile = openFile(filePath, "w+b");
+	if (!packFile)
+	{
+		free(itemOrder);
+		return FAILED_TO_CREATE_FILE_PACK_RESULT;
+	}
+
+	PackHeader header;
+	header.magic = PACK_HEADER_MAGIC;
+	header.versionMajor = PACK_VERSION_MAJOR;
+	header.versionMinor = PACK_VERSION_MINOR;
+	header.versionPatch = PACK_VERSION_PATCH;
+	header.isBigEndian = !PACK_LITTLE_ENDIAN;
+	header.itemCount = itemCount;
+	header.dataVersion = dataVersion;
+	header.preferSpeed = preferSpeed ? 1 : 0;
+	header.dictionarySize = dictionarySize;
+	header.hasChecksums = useChecksums ? 1 : 0;
+	header.indexSize = indexSize;
+
+	size_t writeResult = fwrite(&header, sizeof(PackHeader), 1, packFile);
+	if (writeResult != 1)
+	{
+		closeFile(packFile); remove(filePath); free(itemOrder);
+		return FAILED_TO_WRITE_FILE_PACK_RESULT;
+	}
+
+	packResult = writePackItems(packFile, itemCount, pathPairs, itemOrder, baseReader, 
+		basePackPath, indexSize, dictionary, dictionarySize, zipThreshold, preferSpeed, 
+		useChecksums, solidThreshold, threadCount, printProgress, onPackFile, onItemZip, argument);
+	closeFile(packFile); free(itemOrder);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		remove(filePath);
+		return packResult;
+	}
+
+	return SUCCESS_PACK_RESULT;
+}
+
+static PackResult packPathPairs(const char* filePath, uint64_t itemCount, FileItemPath* pathPairs, 
+	uint32_t dataVersion, float zipThreshold, bool preferSpeed, bool useDictionary, bool useChecksums, 
+	uint32_t threadCount, bool printProgress, uint32_t solidThreshold, uint64_t traceCount, 
+	const char** traceItemPaths, OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument)
+{
+	uint64_t indexSize;
+	PackResult packResult = preparePackPathPairs(pathPairs, itemCount, useChecksums, &indexSize);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	uint8_t* dictionary = NULL; uint32_t dictionarySize = 0;
+	if (useDictionary)
+	{
+		if (printProgress)
+		{
+			printf("Training compression dictionary...\n");
+			fflush(stdout);
+		}
+
+		packResult = trainPackDictionary(itemCount, pathPairs, &dictionary, &dictionarySize);
+		if (packResult != SUCCESS_PACK_RESULT)
+			return packResult;
+	}
+
+	packResult = writePackFile(filePath, itemCount, pathPairs, traceCount, traceItemPaths, NULL, NULL, 
+		indexSize, dataVersion, dictionary, dictionarySize, zipThreshold, preferSpeed, useChecksums, 
+		solidThreshold, threadCount, printProgress, onPackFile, onItemZip, argument);
+	free(dictionary);
+	return packResult;
+}
+
+/**********************************************************************************************************************/
+PackResult packFiles(const char* filePath, uint64_t fileCount, const char** fileItemPaths, uint32_t dataVersion, 
+	float zipThreshold, bool preferSpeed, bool useDictionary, bool useChecksums, uint32_t threadCount, 
+	bool printProgress, uint32_t solidThreshold, uint64_t traceCount, const char** traceItemPaths, 
+	OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument)
+{
+	assert(filePath != NULL);
+	assert(fileCount > 0);
+	assert(fileItemPaths != NULL);
+	assert(solidThreshold <= PACK_BLOCK_SIZE);
+	assert(traceCount == 0 || traceItemPaths != NULL);
+	assert(threadCount > 0);
+
+	FileItemPath* pathPairs = malloc(fileCount * sizeof(FileItemPath));
+	if (!pathPairs)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	uint64_t itemCount = 0;
+	for (uint64_t i = 0; i < fileCount; i++)
+	{
+		bool alreadyAdded = false;
+		for (uint64_t j = 0; j < itemCount; j++)
+		{
+			if (i != j && strcmp(fileItemPaths[i * 2], pathPairs[j].filePath) == 0)
+				alreadyAdded = true;
+		}
+
+		if (!alreadyAdded)
+		{
+			FileItemPath pathPair;
+			pathPair.filePath = fileItemPaths[i * 2];
+			pathPair.itemPath = fileItemPaths[i * 2 + 1];
+			pathPair.itemData = NULL;
+			pathPair.baseItemIndex = UINT64_MAX;
+			pathPair.itemDataSize = 0;
+			pathPairs[itemCount++] = pathPair;
+		}
+	}
+
+	PackResult packResult = packPathPairs(filePath, itemCount, pathPairs, dataVersion, zipThreshold, 
+		preferSpeed, useDictionary, useChecksums, threadCount, printProgress, solidThreshold, traceCount, traceItemPaths, 
+		onPackFile, onItemZip, argument);
+	free(pathPairs);
+	return packResult;
+}
+
+static PackResult readBasePackDictionary(const char* basePackPath, 
+	const PackHeader* baseHeader, uint8_t** dictionary)
+{
+	assert(basePackPath != NULL);
+	assert(baseHeader != NULL);
+	assert(dictionary != NULL);
+
+	*dictionary = NULL;
+	if (baseHeader->dictionarySize == 0)
+		return SUCCESS_PACK_RESULT;
+
+	uint8_t* dictionaryData = malloc(baseHeader->dictionarySize);
+	if (!dictionaryData)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	FILE* baseFile = openFile(basePackPath, "rb");
+	if (!baseFile)
+	{
+		free(dictionaryData);
+		return FAILED_TO_OPEN_FILE_PACK_RESULT;
+	}
+
+	if (seekFile(baseFile, (int64_t)(sizeof(PackHeader) + baseHeader->indexSize), SEEK_SET) != 0)
+	{
+		free(dictionaryData); closeFile(baseFile);
+		return FAILED_TO_SEEK_FILE_PACK_RESULT;
+	}
+
+	size_t result = fread(dictionaryData, sizeof(uint8_t), baseHeader->dictionarySize, baseFile);
+	closeFile(baseFile);
+
+	if (result != baseHeader->dictionarySize)
+	{
+		free(dictionaryData);
+		return FAILED_TO_READ_FILE_PACK_RESULT;
+	}
+
+	*dictionary = dictionaryData;
+	return SUCCESS_PACK_RESULT;
+}
+
+#if _WIN32
+static wchar_t* createWidePackPath(const char* path)
+{
+	assert(path != NULL);
+
+	int pathLength = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+	if (pathLength <= 0)
+		return NULL;
+
+	wchar_t* widePath = malloc(pathLength * sizeof(wchar_t));
+	if (!widePath)
+		return NULL;
+
+	if (MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath, pathLength) != pathLength)
+	{
+		free(widePath);
+		return NULL;
+	}
+	return widePath;
+}
+static bool getPackFileId(const char* path, BY_HANDLE_FILE_INFORMATION* fileInfo)
+{
+	assert(path != NULL);
+	assert(fileInfo != NULL);
+
+	wchar_t* widePath = createWidePackPath(path);
+	if (!widePath)
+		return false;
+
+	HANDLE file = CreateFileW(widePath, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 
+		NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+	free(widePath);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	BOOL result = GetFileInformationByHandle(file, fileInfo);
+	CloseHandle(file);
+	return result ? true : false;
+}
+#endif
+
+// NOTE: Paths are compared by the file identity, so a different spelling or a link to the base pack is detected.
+static bool isSamePackFile(const char* path, const char* otherPath)
+{
+	assert(path != NULL);
+	assert(otherPath != NULL);
+
+	#if _WIN32
+	BY_HANDLE_FILE_INFORMATION fileInfo, otherFileInfo;
+	if (!getPackFileId(path, &fileInfo) || !getPackFileId(otherPath, &otherFileInfo))
+		return false;
+	return fileInfo.dwVolumeSerialNumber == otherFileInfo.dwVolumeSerialNumber &&
+		fileInfo.nFileIndexHigh == otherFileInfo.nFileIndexHigh && 
+		fileInfo.nFileIndexLow == otherFileInfo.nFileIndexLow;
+	#else
+	struct stat fileStat, otherFileStat;
+	if (stat(path, &fileStat) != 0 || stat(otherPath, &otherFileStat) != 0)
+		return false;
+	return fileStat.st_dev == otherFileStat.st_dev && fileStat.st_ino == otherFileStat.st_ino;
+	#endif
+}
+// NOTE: Destination file is replaced atomically, so it's never left missing if the move fails.
+static bool replacePackFile(const char* filePath, const char* newFilePath)
+{
+	assert(filePath != NULL);
+	assert(newFilePath != NULL);
+
+	#if _WIN32
+	wchar_t* widePath = createWidePackPath(filePath);
+	wchar_t* newWidePath = createWidePackPath(newFilePath);
+
+	BOOL result = FALSE;
+	if (widePath && newWidePath)
+		result = MoveFileExW(widePath, newWidePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+	free(newWidePath); free(widePath);
+	return result ? true : false;
+	#else
+	return rename(filePath, newFilePath) == 0;
+	#endif
+}
+
+PackResult updatePackFiles(const char* packPath, const char* basePackPath, uint64_t fileCount, 
+	const char** fileItemPaths, uint32_t dataVersion, float zipThreshold, bool useChecksums, uint32_t threadCount, 
+	bool printProgress, uint32_t solidThreshold, uint64_t traceCount, const char** traceItemPaths, 
+	OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument)
+{
+	assert(packPath != NULL);
+	assert(basePackPath != NULL);
+	assert(fileCount == 0 || fileItemPaths != NULL);
+	assert(solidThreshold <= PACK_BLOCK_SIZE);
+	assert(traceCount == 0 || traceItemPaths != NULL);
+	assert(threadCount > 0);
+
+	PackHeader baseHeader;
+	PackResult packResult = readPackHeader(basePackPath, &baseHeader);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	PackReader baseReader;
+	packResult = createFilePackReader(basePackPath, 0, false, 1, &baseReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	uint64_t baseItemCount = getPackItemCount(baseReader);
+	FileItemPath* pathPairs = malloc((baseItemCount + fileCount) * sizeof(FileItemPath));
+	if (!pathPairs)
+	{
+		destroyPackReader(baseReader);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	bool* isReplaced = calloc(baseItemCount, sizeof(bool));
+	if (!isReplaced)
+	{
+		free(pathPairs); destroyPackReader(baseReader);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	uint64_t itemCount = 0;
+	for (uint64_t i = 0; i < fileCount; i++)
+	{
+		const char* itemPath = fileItemPaths[i * 2 + 1];
+
+		bool alreadyAdded = false;
+		for (uint64_t j = 0; j < itemCount; j++)
+		{
+			if (strcmp(itemPath, pathPairs[j].itemPath) == 0)
+				alreadyAdded = true;
+		}
+		if (alreadyAdded)
+			continue;
+
+		uint64_t baseItemIndex;
+		if (getPackItemIndex(baseReader, itemPath, &baseItemIndex))
+			isReplaced[baseItemIndex] = true;
+
+		FileItemPath pathPair;
+		pathPair.filePath = fileItemPaths[i * 2];
+		pathPair.itemPath = itemPath;
+		pathPair.itemData = NULL;
+		pathPair.baseItemIndex = UINT64_MAX;
+		pathPair.itemDataSize = 0;
+		pathPairs[itemCount++] = pathPair;
+	}
+	for (uint64_t i = 0; i < baseItemCount; i++)
+	{
+		if (isReplaced[i])
+			continue;
+
+		FileItemPath pathPair;
+		pathPair.filePath = NULL;
+		pathPair.itemPath = getPackItemPath(baseReader, i);
+		pathPair.itemData = NULL;
+		pathPair.baseItemIndex = i;
+		pathPair.itemDataSize = 0;
+		pathPairs[itemCount++] = pathPair;
+	}
+	free(isReplaced);
+
+	uint64_t indexSize;
+	packResult = preparePackPathPairs(pathPairs, itemCount, useChecksums, &indexSize);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		free(pathPairs); destroyPackReader(baseReader);
+		return packResult;
+	}
+
+	// NOTE: Unchanged items are compressed with the base pack dictionary, so it should be kept as is.
+	uint8_t* dictionary;
+	packResult = readBasePackDictionary(basePackPath, &baseHeader, &dictionary);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		free(pathPairs); destroyPackReader(baseReader);
+		return packResult;
+	}
+
+	char* tmpPath = NULL;
+	if (isSamePackFile(packPath, basePackPath))
+	{
+		size_t pathLength = strlen(packPath);
+		tmpPath = malloc(pathLength + 5);
+		if (!tmpPath)
+		{
+			free(dictionary); free(pathPairs); destroyPackReader(baseReader);
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+		}
+		memcpy(tmpPath, packPath, pathLength);
+		memcpy(tmpPath + pathLength, ".tmp", 5);
+	}
+
+	packResult = writePackFile(tmpPath ? tmpPath : packPath, itemCount, pathPairs, traceCount, 
+		traceItemPaths, baseReader, basePackPath, indexSize, dataVersion, dictionary, baseHeader.dictionarySize, 
+		zipThreshold, baseHeader.preferSpeed, useChecksums, solidThreshold, threadCount, 
+		printProgress, onPackFile, onItemZip, argument);
+	free(dictionary); free(pathPairs); destroyPackReader(baseReader);
+
+	if (tmpPath)
+	{
+		// NOTE: Base pack is replaced only after the whole updated pack is successfully written.
+		if (packResult == SUCCESS_PACK_RESULT && !replacePackFile(tmpPath, packPath))
+		{
+			remove(tmpPath);
+			packResult = FAILED_TO_WRITE_FILE_PACK_RESULT;
+		}
+		free(tmpPath);
+	}
+	return packResult;
+}
+
+/**********************************************************************************************************************/
+struct PackWriter_T
+{
+	FileItemPath* pathPairs;
+	uint64_t* pathSlots; // NOTE: Item index + 1, or 0 if slot is empty.
+	char* packPath;
+	uint64_t itemCount;
+	uint64_t itemCapacity;
+	uint64_t pathSlotCount;
+	float zipThreshold;
+	uint32_t dataVersion;
+	uint32_t threadCount;
+	uint32_t solidThreshold;
+	bool preferSpeed;
+	bool useDictionary;
+	bool useChecksums;
+};
+
+static char* createPackWriterString(const char* string)
+{
+	assert(string != NULL);
+	size_t stringSize = strlen(string) + 1;
+	char* stringCopy = malloc(stringSize);
+	if (stringCopy)
+		memcpy(stringCopy, string, stringSize);
+	return stringCopy;
+}
+static uint64_t* findPackWriterSlot(PackWriter packWriter, const char* itemPath)
+{
+	assert(packWriter != NULL);
+	assert(itemPath != NULL);
+
+	uint64_t slotMask = packWriter->pathSlotCount - 1;
+	uint64_t slotIndex = hashPackItemPath(itemPath, (uint8_t)strlen(itemPath)) & slotMask;
+
+	while (true)
+	{
+		uint64_t* pathSlot = &packWriter->pathSlots[slotIndex];
+		if (*pathSlot == 0 || strcmp(packWriter->pathPairs[*pathSlot - 1].itemPath, itemPath) == 0)
+			return pathSlot;
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+}
+static bool reservePackWriterSlots(PackWriter packWriter)
+{
+	assert(packWriter != NULL);
+
+	uint64_t pathSlotCount = getPackHashSlotCount(packWriter->itemCount + 1);
+	if (pathSlotCount <= packWriter->pathSlotCount)
+		return true;
+
+	uint64_t* pathSlots = calloc(pathSlotCount, sizeof(uint64_t));
+	if (!pathSlots)
+		return false;
+
+	free(packWriter->pathSlots);
+	packWriter->pathSlots = pathSlots;
+	packWriter->pathSlotCount = pathSlotCount;
+
+	for (uint64_t i = 0; i < packWriter->itemCount; i++)
+		*findPackWriterSlot(packWriter, packWriter->pathPairs[i].itemPath) = i + 1;
+	return true;
+}
+static PackResult addPackWriterItem(PackWriter packWriter, FileItemPath* pathPair)
+{
+	assert(packWriter != NULL);
+	assert(pathPair != NULL);
+
+	if (!reservePackWriterSlots(packWriter))
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	uint64_t* pathSlot = findPackWriterSlot(packWriter, pathPair->itemPath);
+	if (*pathSlot != 0)
+		return DUPLICATE_ITEM_PATH_PACK_RESULT;
+
+	if (packWriter->itemCount == packWriter->itemCapacity)
+	{
+		uint64_t itemCapacity = packWriter->itemCapacity * 2;
+		FileItemPath* pathPairs = realloc(packWriter->pathPairs, itemCapacity * sizeof(FileItemPath));
+		if (!pathPairs)
+			return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+		packWriter->pathPairs = pathPairs;
+		packWriter->itemCapacity = itemCapacity;
+	}
+
+	packWriter->pathPairs[packWriter->itemCount++] = *pathPair;
+	*pathSlot = packWriter->itemCount;
+	return SUCCESS_PACK_RESULT;
+}
+
+PackResult createPackWriter(const char* packPath, uint32_t dataVersion, float zipThreshold, bool preferSpeed, 
+	bool useDictionary, bool useChecksums, uint32_t threadCount, uint32_t solidThreshold, PackWriter* packWriter)
+{
+	assert(packPath != NULL);
+	assert(solidThreshold <= PACK_BLOCK_SIZE);
+	assert(threadCount > 0);
+	assert(packWriter != NULL);
+
+	PackWriter packWriterInstance = calloc(1, sizeof(PackWriter_T));
+	if (!packWriterInstance)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	packWriterInstance->itemCapacity = 16;
+	packWriterInstance->pathPairs = malloc(packWriterInstance->itemCapacity * sizeof(FileItemPath));
+	packWriterInstance->packPath = createPackWriterString(packPath);
+
+	if (!packWriterInstance->pathPairs || !packWriterInstance->packPath)
+	{
+		destroyPackWriter(packWriterInstance);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	packWriterInstance->zipThreshold = zipThreshold;
+	packWriterInstance->dataVersion = dataVersion;
+	packWriterInstance->threadCount = threadCount;
+	packWriterInstance->solidThreshold = solidThreshold;
+	packWriterInstance->preferSpeed = preferSpeed;
+	packWriterInstance->useDictionary = useDictionary;
+	packWriterInstance->useChecksums = useChecksums;
+
+	*packWriter = packWriterInstance;
+	return SUCCESS_PACK_RESULT;
+}
+void destroyPackWriter(PackWriter packWriter)
+{
+	if (!packWriter)
+		return;
+
+	FileItemPath* pathPairs = packWriter->pathPairs;
+	for (uint64_t i = 0; i < packWriter->itemCount; i++)
+	{
+		FileItemPath* pathPair = &pathPairs[i];
+		free((char*)pathPair->filePath);
+		free((char*)pathPair->itemPath);
+		free((uint8_t*)pathPair->itemData);
+	}
+
+	free(pathPairs);
+	free(packWriter->pathSlots);
+	free(packWriter->packPath);
+	free(packWriter);
+}
+
+PackResult addPackItemData(PackWriter packWriter, const char* itemPath, const void* data, uint32_t dataSize)
+{
+	assert(packWriter != NULL);
+	assert(itemPath != NULL);
+	assert(data != NULL);
+
+	// NOTE: Pack reader doesn't accept empty items.
+	if (strlen(itemPath) > UINT8_MAX || dataSize == 0)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	uint8_t* itemData = malloc(dataSize);
+	if (itemData)
+		memcpy(itemData, data, dataSize);
+
+	FileItemPath pathPair;
+	pathPair.filePath = NULL;
+	pathPair.itemPath = createPackWriterString(itemPath);
+	pathPair.itemData = itemData;
+	pathPair.baseItemIndex = UINT64_MAX;
+	pathPair.itemDataSize = dataSize;
+
+	PackResult packResult = !pathPair.itemPath || !itemData ? 
+		FAILED_TO_ALLOCATE_PACK_RESULT : addPackWriterItem(packWriter, &pathPair);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		free(itemData); free((char*)pathPair.itemPath);
+		return packResult;
+	}
+	return SUCCESS_PACK_RESULT;
+}
+PackResult addPackItemFile(PackWriter packWriter, const char* filePath, const char* itemPath)
+{
+	assert(packWriter != NULL);
+	assert(filePath != NULL);
+	assert(itemPath != NULL);
+
+	if (strlen(itemPath) > UINT8_MAX)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	FileItemPath pathPair;
+	pathPair.filePath = createPackWriterString(filePath);
+	pathPair.itemPath = createPackWriterString(itemPath);
+	pathPair.itemData = NULL;
+	pathPair.baseItemIndex = UINT64_MAX;
+	pathPair.itemDataSize = 0;
+
+	PackResult packResult = !pathPair.filePath || !pathPair.itemPath ? 
+		FAILED_TO_ALLOCATE_PACK_RESULT : addPackWriterItem(packWriter, &pathPair);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		free((char*)pathPair.itemPath); free((char*)pathPair.filePath);
+		return packResult;
+	}
+	return SUCCESS_PACK_RESULT;
+}
+
+PackResult finishPackWriter(PackWriter packWriter, bool printProgress, uint64_t traceCount, 
+	const char** traceItemPaths, OnPackFile onPackFile, OnPackItemZip onItemZip, void* argument)
+{
+	assert(packWriter != NULL);
+	assert(traceCount == 0 || traceItemPaths != NULL);
+
+	if (packWriter->itemCount == 0)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	PackResult packResult = packPathPairs(packWriter->packPath, packWriter->itemCount, packWriter->pathPairs, 
+		packWriter->dataVersion, packWriter->zipThreshold, packWriter->preferSpeed, packWriter->useDictionary, 
+		packWriter->useChecksums, packWriter->threadCount, printProgress, packWriter->solidThreshold, traceCount, traceItemPaths, 
+		onPackFile, onItemZip, argument);
+
+	// NOTE: Items are sorted by the packing, so path slots are rebuilt on the next added item.
+	free(packWriter->pathSlots);
+	packWriter->pathSlots = NULL;
+	packWriter->pathSlotCount = 0;
+	return packResult;
+}
+uint64_t getPackWriterItemCount(PackWriter packWriter)
+{
+	assert(packWriter != NULL);
+	return packWriter->itemCount;
+}
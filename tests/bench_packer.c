@@ -0,0 +1,545 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pack/writer.h"
+#include "pack/reader.h"
+#include "mpio/file.h"
+#include "thread.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#if !_WIN32
+#include <time.h>
+#endif
+
+#define BENCH_PACK_PATH "pack-bench.pack"
+#define BENCH_OPEN_COUNT 32
+#define BENCH_LOOKUP_COUNT 1000000
+
+typedef enum BenchCategory_T
+{
+	SMALL_TEXT_BENCH_CATEGORY = 0,
+	MEDIUM_BINARY_BENCH_CATEGORY = 1,
+	LARGE_RANDOM_BENCH_CATEGORY = 2,
+	DUPLICATE_BENCH_CATEGORY = 3,
+	BENCH_CATEGORY_COUNT = 4,
+} BenchCategory_T;
+typedef uint8_t BenchCategory;
+
+static const char* const benchCategoryNames[BENCH_CATEGORY_COUNT] =
+{
+	"small-text", "medium-binary", "large-random", "duplicate",
+};
+static const char* const benchWords[] =
+{
+	"texture", "shader", "mesh", "sound", "level", "entity", "material", "light", "camera", "vertex",
+	"index", "buffer", "uniform", "sampler", "pipeline", "render", "pass", "frame", "image", "font",
+	"the", "a", "of", "and", "to", "in", "is", "with", "for", "on",
+};
+
+typedef struct BenchCorpus
+{
+	char** filePaths;
+	const char** fileItemPaths;
+	uint64_t categoryFileCounts[BENCH_CATEGORY_COUNT];
+	uint64_t categoryDataSizes[BENCH_CATEGORY_COUNT];
+	uint64_t fileCount;
+	uint64_t dataSize;
+} BenchCorpus;
+
+typedef struct BenchReadThread
+{
+	PackReader packReader;
+	const uint8_t* itemMask;
+	uint8_t* buffer;
+	uint64_t readSize;
+	uint32_t threadIndex;
+	uint32_t threadCount;
+	PackResult result;
+} BenchReadThread;
+
+/**********************************************************************************************************************/
+static double getBenchTime()
+{
+	#if _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+	#else
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+	#endif
+}
+
+// NOTE: Fixed seed pseudo random generator, so the corpus is the same on every run and platform.
+inline static uint32_t getBenchRandom(uint64_t* state)
+{
+	*state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (uint32_t)(*state >> 32);
+}
+
+// NOTE: Thread counts are doubled until the maximum, which is always measured too.
+inline static uint32_t getNextBenchThreadCount(uint32_t threadCount, uint32_t maxThreadCount)
+{
+	if (threadCount == maxThreadCount)
+		return UINT32_MAX;
+	return threadCount * 2 < maxThreadCount ? threadCount * 2 : maxThreadCount;
+}
+
+static void generateBenchData(BenchCategory category, uint64_t* random, uint8_t* data, uint32_t dataSize)
+{
+	if (category == SMALL_TEXT_BENCH_CATEGORY)
+	{
+		const uint32_t wordCount = sizeof(benchWords) / sizeof(const char*);
+		uint32_t offset = 0;
+
+		while (offset < dataSize)
+		{
+			const char* word = benchWords[getBenchRandom(random) % wordCount];
+			size_t wordLength = strlen(word);
+
+			for (size_t i = 0; i < wordLength && offset < dataSize; i++)
+				data[offset++] = (uint8_t)word[i];
+			if (offset < dataSize)
+				data[offset++] = getBenchRandom(random) % 12 == 0 ? '\n' : ' ';
+		}
+	}
+	else if (category == LARGE_RANDOM_BENCH_CATEGORY)
+	{
+		for (uint32_t i = 0; i < dataSize; i++)
+			data[i] = (uint8_t)getBenchRandom(random);
+	}
+	else
+	{
+		// NOTE: Mimics vertex and animation data, slowly changing values with some noise.
+		uint32_t value = getBenchRandom(random);
+		for (uint32_t i = 0; i + 4 <= dataSize; i += 4)
+		{
+			value += getBenchRandom(random) % 64;
+			if (getBenchRandom(random) % 16 == 0)
+				value = getBenchRandom(random);
+			memcpy(data + i, &value, sizeof(uint32_t));
+		}
+		memset(data + (dataSize & ~3u), 0, dataSize & 3u);
+	}
+}
+
+/**********************************************************************************************************************/
+static void destroyBenchCorpus(BenchCorpus* corpus)
+{
+	if (corpus->filePaths)
+	{
+		for (uint64_t i = 0; i < corpus->fileCount; i++)
+		{
+			if (!corpus->filePaths[i])
+				continue;
+			remove(corpus->filePaths[i]);
+			free(corpus->filePaths[i]);
+		}
+	}
+
+	free(corpus->filePaths);
+	free((void*)corpus->fileItemPaths);
+}
+static bool createBenchCorpus(uint32_t scale, BenchCorpus* corpus)
+{
+	memset(corpus, 0, sizeof(BenchCorpus));
+
+	const uint64_t fileCounts[BENCH_CATEGORY_COUNT] = { 1000 * scale, 40 * scale, 2 * scale, 400 * scale };
+	const uint32_t minSizes[BENCH_CATEGORY_COUNT] = { 256, 65536, 4194304, 16384 };
+	const uint32_t maxSizes[BENCH_CATEGORY_COUNT] = { 4096, 524288, 4194304, 16384 };
+	const uint64_t uniqueDuplicateCount = 20 * scale;
+
+	uint64_t fileCount = 0;
+	for (uint8_t i = 0; i < BENCH_CATEGORY_COUNT; i++)
+		fileCount += fileCounts[i];
+
+	corpus->filePaths = calloc(fileCount, sizeof(char*));
+	corpus->fileItemPaths = malloc(fileCount * 2 * sizeof(const char*));
+	uint8_t* data = malloc(maxSizes[LARGE_RANDOM_BENCH_CATEGORY]);
+	if (!corpus->filePaths || !corpus->fileItemPaths || !data)
+	{
+		free(data);
+		destroyBenchCorpus(corpus);
+		return false;
+	}
+	corpus->fileCount = fileCount;
+
+	uint64_t random = 0x5041434B42454E43ULL, fileIndex = 0;
+	for (uint8_t category = 0; category < BENCH_CATEGORY_COUNT; category++)
+	{
+		for (uint64_t i = 0; i < fileCounts[category]; i++, fileIndex++)
+		{
+			uint32_t dataSize = minSizes[category] + getBenchRandom(&random) %
+				(maxSizes[category] - minSizes[category] + 1);
+
+			if (category == DUPLICATE_BENCH_CATEGORY)
+			{
+				// NOTE: Each duplicate file has the same content as the other files with the same seed.
+				uint64_t duplicateRandom = i % uniqueDuplicateCount + 1;
+				generateBenchData(category, &duplicateRandom, data, dataSize);
+			}
+			else
+			{
+				generateBenchData(category, &random, data, dataSize);
+			}
+
+			char* filePath = malloc(64);
+			if (!filePath)
+			{
+				free(data);
+				destroyBenchCorpus(corpus);
+				return false;
+			}
+			corpus->filePaths[fileIndex] = filePath;
+
+			// NOTE: Item path is stored right after the file path in the same allocation.
+			snprintf(filePath, 64, "pack-bench-%s-%llu", benchCategoryNames[category], (long long unsigned int)i);
+			char* itemPath = filePath + strlen(filePath) + 1;
+			snprintf(itemPath, 64 - (itemPath - filePath), "%s/%llu",
+				benchCategoryNames[category], (long long unsigned int)i);
+
+			corpus->fileItemPaths[fileIndex * 2] = filePath;
+			corpus->fileItemPaths[fileIndex * 2 + 1] = itemPath;
+			corpus->categoryFileCounts[category]++;
+			corpus->categoryDataSizes[category] += dataSize;
+			corpus->dataSize += dataSize;
+
+			FILE* file = openFile(filePath, "wb");
+			if (!file)
+			{
+				free(data);
+				destroyBenchCorpus(corpus);
+				return false;
+			}
+
+			size_t result = fwrite(data, sizeof(uint8_t), dataSize, file);
+			closeFile(file);
+
+			if (result != dataSize)
+			{
+				free(data);
+				destroyBenchCorpus(corpus);
+				return false;
+			}
+		}
+	}
+
+	free(data);
+	return true;
+}
+
+/**********************************************************************************************************************/
+static PACK_THREAD_RESULT readBenchItems(void* argument)
+{
+	BenchReadThread* readThread = (BenchReadThread*)argument;
+	PackReader packReader = readThread->packReader;
+	uint64_t itemCount = getPackItemCount(packReader);
+
+	for (uint64_t i = readThread->threadIndex; i < itemCount; i += readThread->threadCount)
+	{
+		if (readThread->itemMask && !readThread->itemMask[i])
+			continue;
+
+		PackResult packResult = readPackItemData(packReader, i, readThread->buffer, readThread->threadIndex);
+		if (packResult != SUCCESS_PACK_RESULT)
+		{
+			readThread->result = packResult;
+			break;
+		}
+		readThread->readSize += getPackItemDataSize(packReader, i);
+	}
+
+	PACK_THREAD_RETURN;
+}
+static PackResult readBenchPack(uint32_t threadCount, const uint8_t* itemMask, double* seconds, uint64_t* readSize)
+{
+	PackReader packReader;
+	PackResult packResult = createFilePackReader(BENCH_PACK_PATH, 0, false, threadCount, &packReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+		return packResult;
+
+	uint32_t maxDataSize = 1;
+	uint64_t itemCount = getPackItemCount(packReader);
+	for (uint64_t i = 0; i < itemCount; i++)
+	{
+		uint32_t dataSize = getPackItemDataSize(packReader, i);
+		if (dataSize > maxDataSize)
+			maxDataSize = dataSize;
+	}
+
+	BenchReadThread* readThreads = calloc(threadCount, sizeof(BenchReadThread));
+	PackThread* threads = malloc(threadCount * sizeof(PackThread));
+	if (!readThreads || !threads)
+	{
+		free(threads); free(readThreads);
+		destroyPackReader(packReader);
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	packResult = SUCCESS_PACK_RESULT;
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		BenchReadThread* readThread = &readThreads[i];
+		readThread->packReader = packReader;
+		readThread->itemMask = itemMask;
+		readThread->threadIndex = i;
+		readThread->threadCount = threadCount;
+		readThread->result = SUCCESS_PACK_RESULT;
+		readThread->buffer = malloc(maxDataSize);
+		if (!readThread->buffer)
+			packResult = FAILED_TO_ALLOCATE_PACK_RESULT;
+	}
+
+	uint32_t startedCount = 0;
+	double startTime = getBenchTime();
+
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		for (; startedCount < threadCount; startedCount++)
+		{
+			if (!createPackThread(readBenchItems, &readThreads[startedCount], &threads[startedCount]))
+			{
+				packResult = FAILED_TO_ALLOCATE_PACK_RESULT;
+				break;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < startedCount; i++)
+		joinPackThread(threads[i]);
+	*seconds = getBenchTime() - startTime;
+
+	*readSize = 0;
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		BenchReadThread* readThread = &readThreads[i];
+		if (packResult == SUCCESS_PACK_RESULT)
+			packResult = readThread->result;
+		*readSize += readThread->readSize;
+		free(readThread->buffer);
+	}
+
+	free(threads); free(readThreads);
+	destroyPackReader(packReader);
+	return packResult;
+}
+
+/**********************************************************************************************************************/
+static PackResult benchPackAlgorithm(FILE* output, const BenchCorpus* corpus, bool preferSpeed, uint32_t maxThreadCount)
+{
+	fprintf(output, "\t\t{\n\t\t\t\"algorithm\": \"%s\",\n\t\t\t\"pack\": [", preferSpeed ? "lz4" : "zstd");
+
+	for (uint32_t threadCount = 1; threadCount <= maxThreadCount;
+		threadCount = getNextBenchThreadCount(threadCount, maxThreadCount))
+	{
+		fprintf(stderr, "Packing %s with %u thread(s)...\n", preferSpeed ? "LZ4" : "ZSTD", threadCount);
+
+		double startTime = getBenchTime();
+		PackResult packResult = packFiles(BENCH_PACK_PATH, corpus->fileCount, corpus->fileItemPaths,
+			0, 0.1f, preferSpeed, false, false, threadCount, false, 0, 0, NULL, NULL, NULL, NULL);
+		double seconds = getBenchTime() - startTime;
+		if (packResult != SUCCESS_PACK_RESULT)
+			return packResult;
+
+		FILE* packFile = openFile(BENCH_PACK_PATH, "rb");
+		if (!packFile)
+			return FAILED_TO_OPEN_FILE_PACK_RESULT;
+		seekFile(packFile, 0, SEEK_END);
+		uint64_t packSize = (uint64_t)tellFile(packFile);
+		closeFile(packFile);
+
+		fprintf(output, "%s\n\t\t\t\t{ \"threadCount\": %u, \"seconds\": %.6f, \"megabytesPerSecond\": %.3f, "
+			"\"packSize\": %llu }", threadCount == 1 ? "" : ",", threadCount, seconds,
+			(double)corpus->dataSize / seconds / 1048576.0, (long long unsigned int)packSize);
+	}
+
+	fprintf(stderr, "Opening %s pack...\n", preferSpeed ? "LZ4" : "ZSTD");
+
+	PackReader packReader = NULL;
+	double startTime = getBenchTime();
+	for (uint32_t i = 0; i < BENCH_OPEN_COUNT; i++)
+	{
+		if (packReader)
+			destroyPackReader(packReader);
+
+		PackResult packResult = createFilePackReader(BENCH_PACK_PATH, 0, false, 1, &packReader);
+		if (packResult != SUCCESS_PACK_RESULT)
+			return packResult;
+	}
+	double openSeconds = (getBenchTime() - startTime) / BENCH_OPEN_COUNT;
+
+	uint64_t itemCount = getPackItemCount(packReader), foundCount = 0;
+	startTime = getBenchTime();
+	for (uint64_t i = 0; i < BENCH_LOOKUP_COUNT; i++)
+	{
+		uint64_t itemIndex;
+		foundCount += getPackItemIndex(packReader, corpus->fileItemPaths[(i % itemCount) * 2 + 1], &itemIndex);
+	}
+	double lookupSeconds = getBenchTime() - startTime;
+	destroyPackReader(packReader);
+
+	if (foundCount != BENCH_LOOKUP_COUNT)
+		return BAD_DATA_SIZE_PACK_RESULT;
+
+	fprintf(output, "\n\t\t\t],\n\t\t\t\"openSeconds\": %.9f,\n\t\t\t\"lookupNanoseconds\": %.3f,\n\t\t\t\"read\": [",
+		openSeconds, lookupSeconds * 1e9 / BENCH_LOOKUP_COUNT);
+
+	for (uint32_t threadCount = 1; threadCount <= maxThreadCount;
+		threadCount = getNextBenchThreadCount(threadCount, maxThreadCount))
+	{
+		fprintf(stderr, "Reading %s pack with %u thread(s)...\n", preferSpeed ? "LZ4" : "ZSTD", threadCount);
+
+		double seconds; uint64_t readSize;
+		PackResult packResult = readBenchPack(threadCount, NULL, &seconds, &readSize);
+		if (packResult != SUCCESS_PACK_RESULT)
+			return packResult;
+
+		fprintf(output, "%s\n\t\t\t\t{ \"threadCount\": %u, \"seconds\": %.6f, \"megabytesPerSecond\": %.3f }",
+			threadCount == 1 ? "" : ",", threadCount, seconds, (double)readSize / seconds / 1048576.0);
+	}
+
+	fprintf(output, "\n\t\t\t],\n\t\t\t\"categoryRead\": [");
+
+	// NOTE: Pack item order differs from the file order, so categories are matched by the item path.
+	uint8_t* itemMask = malloc(corpus->fileCount);
+	if (!itemMask)
+		return FAILED_TO_ALLOCATE_PACK_RESULT;
+
+	for (uint8_t category = 0; category < BENCH_CATEGORY_COUNT; category++)
+	{
+		PackResult packResult = createFilePackReader(BENCH_PACK_PATH, 0, false, 1, &packReader);
+		if (packResult != SUCCESS_PACK_RESULT)
+		{
+			free(itemMask);
+			return packResult;
+		}
+
+		const char* categoryName = benchCategoryNames[category];
+		size_t nameLength = strlen(categoryName);
+		for (uint64_t i = 0; i < itemCount; i++)
+		{
+			const char* itemPath = getPackItemPath(packReader, i);
+			itemMask[i] = strncmp(itemPath, categoryName, nameLength) == 0 && itemPath[nameLength] == '/';
+		}
+		destroyPackReader(packReader);
+
+		double seconds; uint64_t readSize;
+		packResult = readBenchPack(1, itemMask, &seconds, &readSize);
+		if (packResult != SUCCESS_PACK_RESULT)
+		{
+			free(itemMask);
+			return packResult;
+		}
+
+		fprintf(output, "%s\n\t\t\t\t{ \"name\": \"%s\", \"seconds\": %.6f, \"megabytesPerSecond\": %.3f }",
+			category == 0 ? "" : ",", categoryName, seconds, (double)readSize / seconds / 1048576.0);
+	}
+
+	free(itemMask);
+	fprintf(output, "\n\t\t\t]\n\t\t}");
+	return SUCCESS_PACK_RESULT;
+}
+
+/**********************************************************************************************************************/
+static void printPackBenchHelp()
+{
+	printf("Usage: pack-bench [-j, -s, -o]\n"
+		"\n"
+		"Options:\n"
+		"  -j <threadCount>  Specifies maximum benchmark thread count. Default value is 4.\n"
+		"  -s <scale>        Specifies generated corpus size multiplier. Default value is 1.\n"
+		"  -o <jsonPath>     Writes JSON results to the file instead of the stdout.\n"
+	);
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t maxThreadCount = 4, scale = 1;
+	const char* outputPath = NULL;
+
+	for (int i = 1; i < argc; i += 2)
+	{
+		if (i + 1 >= argc)
+		{
+			printPackBenchHelp();
+			return EXIT_FAILURE;
+		}
+
+		int value = atoi(argv[i + 1]);
+		if (strcmp(argv[i], "-j") == 0 && value > 0)
+			maxThreadCount = (uint32_t)value;
+		else if (strcmp(argv[i], "-s") == 0 && value > 0)
+			scale = (uint32_t)value;
+		else if (strcmp(argv[i], "-o") == 0)
+			outputPath = argv[i + 1];
+		else
+		{
+			printPackBenchHelp();
+			return EXIT_FAILURE;
+		}
+	}
+
+	fprintf(stderr, "Generating benchmark corpus...\n");
+
+	BenchCorpus corpus;
+	if (!createBenchCorpus(scale, &corpus))
+	{
+		fprintf(stderr, "Error: Failed to create benchmark corpus.\n");
+		return EXIT_FAILURE;
+	}
+
+	FILE* output = outputPath ? openFile(outputPath, "w") : stdout;
+	if (!output)
+	{
+		destroyBenchCorpus(&corpus);
+		fprintf(stderr, "Error: Failed to open output file.\n");
+		return EXIT_FAILURE;
+	}
+
+	fprintf(output, "{\n\t\"version\": \"%d.%d.%d\",\n\t\"scale\": %u,\n\t\"maxThreadCount\": %u,\n\t\"corpus\": [",
+		PACK_VERSION_MAJOR, PACK_VERSION_MINOR, PACK_VERSION_PATCH, scale, maxThreadCount);
+	for (uint8_t i = 0; i < BENCH_CATEGORY_COUNT; i++)
+	{
+		fprintf(output, "%s\n\t\t{ \"name\": \"%s\", \"fileCount\": %llu, \"dataSize\": %llu }", i == 0 ? "" : ",",
+			benchCategoryNames[i], (long long unsigned int)corpus.categoryFileCounts[i],
+			(long long unsigned int)corpus.categoryDataSizes[i]);
+	}
+	fprintf(output, "\n\t],\n\t\"results\": [\n");
+
+	PackResult packResult = benchPackAlgorithm(output, &corpus, false, maxThreadCount);
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		fprintf(output, ",\n");
+		packResult = benchPackAlgorithm(output, &corpus, true, maxThreadCount);
+	}
+	fprintf(output, "\n\t]\n}\n");
+
+	if (outputPath)
+		closeFile(output);
+	destroyBenchCorpus(&corpus);
+	remove(BENCH_PACK_PATH);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		fprintf(stderr, "Error: %s.\n", packResultToString(packResult));
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -12,8 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
 #include "pack/writer.h"
 #include "pack/reader.h"
+#include "pack/overlay.h"
 #include "mpio/file.h"
 #include "mpio/directory.h"
 
@@ -21,6 +26,15 @@
 #include <assert.h>
 #include <stdlib.h>
 
+#if __linux__
+#include <dlfcn.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+
 #define LOREM_IPSUM "Lorem ipsum dolor sit amet, consectetur adipiscing elit. " \
 	"Maecenas aliquet maximus condimentum. Cras et rhoncus eros, tincidunt " \
 	"congue nulla. Fusce consequat tristique nisl, nec varius neque finibus " \
@@ -31,6 +45,61 @@
 	"malesuada. Nam a est at ligula accumsan dignissim. Pellentesque habitant " \
 	"morbi tristique senectus et netus et malesuada fames ac turpis egestas. "
 #define TEST_FILE_NAME "test.pack"
+#define TEST_PATCH_FILE_NAME "test-patch.pack"
+
+#if __linux__
+// NOTE: Kernel copy calls are replaced by the test, to check the unpacker fallback and the partial copy resume.
+static bool isKernelCopyFailing = false;
+
+long syscall(long number, ...)
+{
+	va_list args;
+	va_start(args, number);
+	long a0 = va_arg(args, long), a1 = va_arg(args, long), a2 = va_arg(args, long);
+	long a3 = va_arg(args, long), a4 = va_arg(args, long), a5 = va_arg(args, long);
+	va_end(args);
+
+	#ifdef SYS_copy_file_range
+	if (isKernelCopyFailing && number == SYS_copy_file_range)
+	{
+		errno = EXDEV;
+		return -1;
+	}
+	#endif
+
+	long(*nextSyscall)(long, ...) = (long(*)(long, ...))dlsym(RTLD_NEXT, "syscall");
+	return nextSyscall(number, a0, a1, a2, a3, a4, a5);
+}
+ssize_t sendfile(int outFile, int inFile, off_t* offset, size_t count)
+{
+	if (!isKernelCopyFailing)
+	{
+		ssize_t(*nextSendfile)(int, int, off_t*, size_t) = 
+			(ssize_t(*)(int, int, off_t*, size_t))dlsym(RTLD_NEXT, "sendfile");
+		return nextSendfile(outFile, inFile, offset, count);
+	}
+
+	// NOTE: Copies only a half of the large ranges, so the unpacker has to finish the item by itself.
+	if (count <= 4096)
+	{
+		errno = EINVAL;
+		return -1;
+	}
+
+	uint8_t buffer[4096]; size_t copySize = count / 2, copiedSize = 0;
+	while (copiedSize < copySize)
+	{
+		size_t chunkSize = copySize - copiedSize < sizeof(buffer) ? copySize - copiedSize : sizeof(buffer);
+		ssize_t result = pread(inFile, buffer, chunkSize, *offset + (off_t)copiedSize);
+		if (result <= 0 || write(outFile, buffer, (size_t)result) != result)
+			return -1;
+		copiedSize += (size_t)result;
+	}
+
+	*offset += (off_t)copiedSize;
+	return (ssize_t)copiedSize;
+}
+#endif
 
 inline static bool createTestFile(const char* path,
 	const void* content, size_t contentLength)
@@ -57,6 +126,40 @@ inline static bool createTestFile(const char* path,
 	return true;
 }
 
+static void fillTestData(uint8_t* data, uint32_t dataSize, uint32_t seed, bool isRandom)
+{
+	assert(data);
+	uint32_t state = seed * 2654435761u + 1;
+	for (uint32_t i = 0; i < dataSize; i++)
+	{
+		if (isRandom)
+		{
+			state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+			data[i] = (uint8_t)state;
+		}
+		else
+		{
+			data[i] = (uint8_t)LOREM_IPSUM[(i + seed) % (sizeof(LOREM_IPSUM) - 1)];
+		}
+	}
+}
+
+static PackZipType onTestItemZip(const char* itemPath, uint32_t dataSize, void* argument)
+{
+	(void)dataSize; (void)argument;
+	if (strcmp(itemPath, "lorem-ipsum") == 0)
+		return LZ4_PACK_ZIP_TYPE;
+	if (strcmp(itemPath, "new/_BIN654_") == 0)
+		return NONE_PACK_ZIP_TYPE;
+	return DEFAULT_PACK_ZIP_TYPE;
+}
+static void onTestItemRead(uint64_t itemIndex, uint8_t* buffer, PackResult result, void* argument)
+{
+	(void)itemIndex; (void)buffer;
+	assert(argument);
+	*(PackResult*)argument = result;
+}
+
 /**********************************************************************************************************************/
 inline static bool testFailedToOpenFile()
 {
@@ -75,7 +178,7 @@ inline static bool testFailedToOpenFile()
 	return true;
 }
 
-inline static bool testPacker(bool preferSpeed)
+inline static bool testPacker(bool preferSpeed, bool useDictionary, bool isMapped)
 {
 	const char* files[6] =
 	{
@@ -102,8 +205,13 @@ inline static bool testPacker(bool preferSpeed)
 		return false;
 	}
 	
-	PackResult packResult = packFiles(TEST_FILE_NAME, 3, 
-		files, 123, 0.1f, preferSpeed, false, NULL, NULL);
+	const char* traceItemPaths[3] =
+	{
+		"files/тест", "missing", "_BIN321_"
+	};
+	
+	PackResult packResult = packFiles(TEST_FILE_NAME, 3, files, 123, 0.1f, preferSpeed, 
+		useDictionary, true, isMapped ? 2 : 1, false, 0, 3, traceItemPaths, NULL, NULL, NULL);
 	remove(files[0]); remove(files[2]); remove(files[4]);
 
 	if (packResult != SUCCESS_PACK_RESULT)
@@ -114,7 +222,9 @@ inline static bool testPacker(bool preferSpeed)
 	}
 
 	PackReader packReader;
-	packResult = createFilePackReader(TEST_FILE_NAME, 123, false, 1, &packReader);
+	if (isMapped)
+		packResult = createMappedPackReader(TEST_FILE_NAME, 123, false, 1, &packReader);
+	else packResult = createFilePackReader(TEST_FILE_NAME, 123, false, 1, &packReader);
 
 	if (packResult != SUCCESS_PACK_RESULT)
 	{
@@ -128,6 +238,25 @@ inline static bool testPacker(bool preferSpeed)
 		return false;
 	}
 
+	uint64_t traceItemIndices[3];
+	if (!getPackItemIndex(packReader, traceItemPaths[0], &traceItemIndices[0]) ||
+		!getPackItemIndex(packReader, traceItemPaths[2], &traceItemIndices[1]) ||
+		!getPackItemIndex(packReader, "lorem-ipsum", &traceItemIndices[2]))
+	{
+		printf("testPacker: item not found.");
+		return false;
+	}
+
+	uint64_t traceOffsets[3];
+	for (int i = 0; i < 3; i++)
+		traceOffsets[i] = getPackItemFileOffset(packReader, traceItemIndices[i]);
+
+	if (traceOffsets[0] >= traceOffsets[1] || traceOffsets[1] >= traceOffsets[2])
+	{
+		printf("testPacker: bad traced item data order.");
+		return false;
+	}
+
 	uint64_t itemIndex;
 	if (!getPackItemIndex(packReader, "lorem-ipsum", &itemIndex))
 	{
@@ -135,6 +264,18 @@ inline static bool testPacker(bool preferSpeed)
 		return false;
 	}
 
+	setPackReaderAccess(packReader, RANDOM_PACK_ACCESS);
+	setPackReaderVerify(packReader, true);
+	packResult = prefetchPackItems(packReader, &itemIndex, 1);
+
+	if (packResult != SUCCESS_PACK_RESULT || getPackReaderAccess(packReader) != RANDOM_PACK_ACCESS ||
+		!isPackReaderVerify(packReader))
+	{
+		printf("testPacker: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
 	uint32_t itemSize = getPackItemDataSize(packReader, itemIndex);
 	char* loremIpsum = malloc(itemSize + 1);
 	packResult = readPackItemData(packReader, itemIndex, (uint8_t*)loremIpsum, 0);
@@ -154,6 +295,109 @@ inline static bool testPacker(bool preferSpeed)
 		free(loremIpsum);
 		return false;
 	}
+
+	uint32_t checksum;
+	if (!getPackItemChecksum(packReader, itemIndex, &checksum) || 
+		checksum != computePackChecksum((const uint8_t*)LOREM_IPSUM, strlen(LOREM_IPSUM), 0))
+	{
+		printf("testPacker: bad item checksum.");
+		free(loremIpsum);
+		return false;
+	}
+
+	packResult = setPackItemCacheCapacity(packReader, 1024 * 1024);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPacker: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		free(loremIpsum);
+		return false;
+	}
+
+	memset(loremIpsum, 0, itemSize);
+	packResult = readPackItemData(packReader, itemIndex, (uint8_t*)loremIpsum, 0);
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		memset(loremIpsum, 0, itemSize);
+		packResult = readPackItemDataConcurrent(packReader, itemIndex, (uint8_t*)loremIpsum);
+	}
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPacker: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		free(loremIpsum);
+		return false;
+	}
+	if (strcmp(LOREM_IPSUM, loremIpsum) != 0)
+	{
+		printf("testPacker: bad concurrent item data.");
+		free(loremIpsum);
+		return false;
+	}
+
+	PackCacheStats cacheStats;
+	getPackItemCacheStats(packReader, &cacheStats);
+
+	if (getPackItemZipSize(packReader, itemIndex) > 0 && 
+		(cacheStats.hitCount != 1 || cacheStats.missCount != 1 || cacheStats.itemCount != 1))
+	{
+		printf("testPacker: bad item cache stats.");
+		free(loremIpsum);
+		return false;
+	}
+
+	PackReaderStats readerStats;
+	getPackReaderStats(packReader, &readerStats);
+	uint32_t zipSize = getPackItemZipSize(packReader, itemIndex);
+
+	if (readerStats.lookupCount != 4 || readerStats.lookupMissCount != 0 || (zipSize > 0 ?
+		readerStats.itemReadCount != 2 || readerStats.zipReadSize != zipSize * 2 :
+		readerStats.itemReadCount != 3 || readerStats.rawReadSize != itemSize * 3))
+	{
+		printf("testPacker: bad reader stats.");
+		free(loremIpsum);
+		return false;
+	}
+
+	PackItemStream itemStream;
+	packResult = openPackItemStream(packReader, itemIndex, &itemStream);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPacker: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		free(loremIpsum);
+		return false;
+	}
+
+	uint32_t streamSize = 0, chunkSize = 0;
+	memset(loremIpsum, 0, itemSize);
+
+	do
+	{
+		// NOTE: Stream never writes past the item data end.
+		packResult = readPackItemStream(itemStream, (uint8_t*)loremIpsum + streamSize, 7, &chunkSize);
+		streamSize += chunkSize;
+	} while (packResult == SUCCESS_PACK_RESULT && chunkSize > 0);
+	closePackItemStream(itemStream);
+
+	if (packResult != SUCCESS_PACK_RESULT || streamSize != itemSize || strcmp(LOREM_IPSUM, loremIpsum) != 0)
+	{
+		printf("testPacker: bad streamed item data.");
+		free(loremIpsum);
+		return false;
+	}
+
+	memset(loremIpsum, 0, itemSize);
+	packResult = readPackItemRange(packReader, itemIndex, 6, 5, (uint8_t*)loremIpsum);
+
+	if (packResult != SUCCESS_PACK_RESULT || memcmp(loremIpsum, "ipsum", 5) != 0)
+	{
+		printf("testPacker: bad item data range.");
+		free(loremIpsum);
+		return false;
+	}
 	free(loremIpsum);
 
 	if (!getPackItemIndex(packReader, "_BIN321_", &itemIndex))
@@ -179,7 +423,50 @@ inline static bool testPacker(bool preferSpeed)
 	if (memcmp(floats, floatData, sizeof(floats)) != 0)
 	{
 		printf("testPacker: bad item data.");
-		free(loremIpsum);
+		return false;
+	}
+
+	const uint8_t* floatPointer = getPackItemDataPointer(packReader, itemIndex);
+	if (isMapped && getPackItemZipSize(packReader, itemIndex) == 0)
+	{
+		if (!floatPointer || memcmp(floats, floatPointer, sizeof(floats)) != 0)
+		{
+			printf("testPacker: bad mapped item data.");
+			return false;
+		}
+	}
+	else if (floatPointer)
+	{
+		printf("testPacker: unexpected item data pointer.");
+		return false;
+	}
+
+	PackReadQueue readQueue;
+	packResult = createPackReadQueue(packReader, 4, onTestItemRead, &readQueue);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPacker: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	PackResult readResult = FAILED_TO_READ_FILE_PACK_RESULT;
+	memset(floatData, 0, sizeof(floats));
+	packResult = submitPackItemRead(readQueue, itemIndex, (uint8_t*)floatData, &readResult);
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = processPackReadQueue(readQueue, true);
+	destroyPackReadQueue(readQueue);
+
+	if (packResult != SUCCESS_PACK_RESULT || readResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPacker: incorrect queue result. "
+			"(%s)\n", packResultToString(readResult));
+		return false;
+	}
+	if (memcmp(floats, floatData, sizeof(floats)) != 0)
+	{
+		printf("testPacker: bad queued item data.");
 		return false;
 	}
 
@@ -190,14 +477,744 @@ inline static bool testPacker(bool preferSpeed)
 	}
 
 	destroyPackReader(packReader);
+
+	packResult = verifyPackFiles(TEST_FILE_NAME, 2, false);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPacker: incorrect verify result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+	return true;
+}
+
+#define BATCH_ITEM_COUNT 28
+
+inline static bool testPackBatch(bool isMapped)
+{
+	// NOTE: Random items are stored raw and split the merged reads by the gap and the read size limits.
+	uint8_t* itemData[BATCH_ITEM_COUNT]; uint32_t itemSizes[BATCH_ITEM_COUNT]; char itemPaths[BATCH_ITEM_COUNT][32];
+	for (uint32_t i = 0; i < BATCH_ITEM_COUNT; i++)
+	{
+		bool isRandom = i >= 24;
+		if (i == BATCH_ITEM_COUNT - 1)
+			itemSizes[i] = 4718592;
+		else if (isRandom)
+			itemSizes[i] = 24576 + i;
+		else
+			itemSizes[i] = 64 + i * 97;
+
+		sprintf(itemPaths[i], isRandom ? "batch/noise-%u" : "batch/text-%u", i);
+		itemData[i] = malloc(itemSizes[i]);
+		if (!itemData[i])
+			return false;
+		fillTestData(itemData[i], itemSizes[i], i, isRandom);
+	}
+
+	PackWriter packWriter;
+	PackResult packResult = createPackWriter(TEST_FILE_NAME, 0, 0.1f, false, false, false, 2, 512, &packWriter);
+	for (uint32_t i = 0; i < BATCH_ITEM_COUNT && packResult == SUCCESS_PACK_RESULT; i++)
+		packResult = addPackItemData(packWriter, itemPaths[i], itemData[i], itemSizes[i]);
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = finishPackWriter(packWriter, false, 0, NULL, NULL, NULL, NULL);
+	destroyPackWriter(packWriter);
+
+	PackReader packReader;
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		if (isMapped)
+			packResult = createMappedPackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+		else packResult = createFilePackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+	}
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = setPackItemCacheCapacity(packReader, 1048576);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPackBatch: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		for (uint32_t i = 0; i < BATCH_ITEM_COUNT; i++)
+			free(itemData[i]);
+		return false;
+	}
+
+	// NOTE: Every third item is skipped, some are requested twice and the order is shuffled.
+	uint32_t batchItems[BATCH_ITEM_COUNT * 2]; uint64_t itemIndices[BATCH_ITEM_COUNT * 2];
+	uint8_t* buffers[BATCH_ITEM_COUNT * 2]; uint32_t batchCount = 0, seed = 12345;
+	for (uint32_t i = 0; i < BATCH_ITEM_COUNT; i++)
+	{
+		if (i % 3 != 1)
+			batchItems[batchCount++] = i;
+		if (i % 5 == 0)
+			batchItems[batchCount++] = i;
+	}
+	for (uint32_t i = batchCount - 1; i > 0; i--)
+	{
+		seed = seed * 1103515245u + 12345u;
+		uint32_t j = (seed >> 8) % (i + 1), item = batchItems[i];
+		batchItems[i] = batchItems[j]; batchItems[j] = item;
+	}
+
+	bool isSuccess = true;
+	for (uint32_t i = 0; i < batchCount; i++)
+	{
+		isSuccess &= getPackItemIndex(packReader, itemPaths[batchItems[i]], &itemIndices[i]);
+		buffers[i] = malloc(itemSizes[batchItems[i]]);
+		isSuccess &= buffers[i] != NULL;
+	}
+
+	// NOTE: Some compressed items are decompressed in advance, so the batch takes them from the item cache.
+	uint8_t* cachedData = malloc(itemSizes[23]);
+	for (uint32_t i = 16; i < 24 && isSuccess; i++)
+	{
+		uint64_t itemIndex;
+		isSuccess &= cachedData && getPackItemIndex(packReader, itemPaths[i], &itemIndex) && 
+			readPackItemData(packReader, itemIndex, cachedData, 0) == SUCCESS_PACK_RESULT;
+	}
+	free(cachedData);
+
+	PackCacheStats cacheStats;
+	getPackItemCacheStats(packReader, &cacheStats);
+	uint64_t hitCount = cacheStats.hitCount;
+
+	if (isSuccess)
+		packResult = readPackItemsBatch(packReader, itemIndices, buffers, batchCount, 0);
+	getPackItemCacheStats(packReader, &cacheStats);
+
+	for (uint32_t i = 0; i < batchCount; i++)
+	{
+		if (isSuccess && packResult == SUCCESS_PACK_RESULT)
+			isSuccess &= memcmp(buffers[i], itemData[batchItems[i]], itemSizes[batchItems[i]]) == 0;
+		free(buffers[i]);
+	}
+	for (uint32_t i = 0; i < BATCH_ITEM_COUNT; i++)
+		free(itemData[i]);
+	destroyPackReader(packReader);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPackBatch: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+	if (!isSuccess || cacheStats.hitCount == hitCount)
+	{
+		printf("testPackBatch: bad batch item data.");
+		return false;
+	}
+	return true;
+}
+
+inline static bool testUnpack(bool isCopyFailing)
+{
+	const char* itemPaths[5] =
+	{
+		"unpack/noise", "unpack/tiny-noise", "unpack/text", "unpack/solid-a", "unpack/solid-b"
+	};
+	const uint32_t itemSizes[5] =
+	{
+		65536 + 123, 1000, 3000, 100, 200
+	};
+	const char* filePaths[5] =
+	{
+		"unpack-noise", "unpack-tiny-noise", "unpack-text", "unpack-solid-a", "unpack-solid-b"
+	};
+
+	uint8_t* itemData[5];
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		itemData[i] = malloc(itemSizes[i]);
+		if (!itemData[i])
+			return false;
+		fillTestData(itemData[i], itemSizes[i], i, i < 2);
+	}
+
+	PackWriter packWriter;
+	PackResult packResult = createPackWriter(TEST_FILE_NAME, 0, 0.1f, false, false, false, 1, 512, &packWriter);
+	for (uint32_t i = 0; i < 5 && packResult == SUCCESS_PACK_RESULT; i++)
+		packResult = addPackItemData(packWriter, itemPaths[i], itemData[i], itemSizes[i]);
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = finishPackWriter(packWriter, false, 0, NULL, NULL, NULL, NULL);
+	destroyPackWriter(packWriter);
+
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		#if __linux__
+		isKernelCopyFailing = isCopyFailing;
+		#endif
+		packResult = unpackFiles(TEST_FILE_NAME, 3, false);
+		#if __linux__
+		isKernelCopyFailing = false;
+		#endif
+	}
+
+	bool isSuccess = true;
+	for (uint32_t i = 0; i < 5; i++)
+	{
+		FILE* file = openFile(filePaths[i], "rb");
+		if (file)
+		{
+			uint8_t* fileData = malloc(itemSizes[i] + 1);
+			isSuccess &= fileData && fread(fileData, sizeof(uint8_t), itemSizes[i] + 1, file) == itemSizes[i] &&
+				memcmp(fileData, itemData[i], itemSizes[i]) == 0;
+			free(fileData);
+			closeFile(file);
+		}
+		else
+		{
+			isSuccess = false;
+		}
+
+		remove(filePaths[i]);
+		free(itemData[i]);
+	}
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testUnpack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+	if (!isSuccess)
+	{
+		printf("testUnpack: bad unpacked file data.");
+		return false;
+	}
+	return true;
+}
+
+inline static bool testUpdatePack(bool preferSpeed)
+{
+	const char* files[4] =
+	{
+		"lorem-ipsum.txt", "lorem-ipsum",
+		"_BIN123", "_BIN321_"
+	};
+	const char* updateFiles[4] =
+	{
+		"_BIN123", "_BIN321_",
+		"_BIN456", "new/_BIN654_"
+	};
+	const uint8_t bytes[8] = 
+	{
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+
+	if (!createTestFile(files[0], LOREM_IPSUM, strlen(LOREM_IPSUM)) ||
+		!createTestFile(files[2], bytes, 4) || !createTestFile(updateFiles[2], bytes, sizeof(bytes)))
+	{
+		remove(files[0]); remove(files[2]); remove(updateFiles[2]);
+		return false;
+	}
+
+	PackResult packResult = packFiles(TEST_FILE_NAME, 2, 
+		files, 123, 0.1f, preferSpeed, false, false, 1, false, 0, 0, NULL, NULL, onTestItemZip, NULL);
+	if (packResult == SUCCESS_PACK_RESULT && !createTestFile(files[2], bytes, sizeof(bytes)))
+		packResult = FAILED_TO_WRITE_FILE_PACK_RESULT;
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		// NOTE: Differently spelled path to the base pack should still be updated through the temporary file.
+		packResult = updatePackFiles("./" TEST_FILE_NAME, TEST_FILE_NAME, 
+			2, updateFiles, 124, 0.1f, true, 2, false, 0, 0, NULL, NULL, onTestItemZip, NULL);
+	}
+	remove(files[0]); remove(files[2]); remove(updateFiles[2]);
+
+	FILE* tmpFile = openFile("./" TEST_FILE_NAME ".tmp", "rb");
+	if (tmpFile)
+	{
+		closeFile(tmpFile);
+		printf("testUpdatePack: temporary file is not removed.");
+		return false;
+	}
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testUpdatePack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	PackReader packReader;
+	packResult = createFilePackReader(TEST_FILE_NAME, 124, false, 1, &packReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testUpdatePack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+	if (getPackItemCount(packReader) != 3 || isPackPreferSpeed(packReader) != preferSpeed)
+	{
+		printf("testUpdatePack: bad updated pack.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	uint64_t itemIndex; char loremIpsum[sizeof(LOREM_IPSUM)]; uint32_t checksum;
+	if (!getPackItemIndex(packReader, "lorem-ipsum", &itemIndex) || 
+		getPackItemDataSize(packReader, itemIndex) != strlen(LOREM_IPSUM) ||
+		!getPackItemChecksum(packReader, itemIndex, &checksum) || 
+		checksum != computePackChecksum((const uint8_t*)LOREM_IPSUM, strlen(LOREM_IPSUM), 0) ||
+		readPackItemData(packReader, itemIndex, (uint8_t*)loremIpsum, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(loremIpsum, LOREM_IPSUM, strlen(LOREM_IPSUM)) != 0 || 
+		(getPackItemZipSize(packReader, itemIndex) > 0 && !isPackItemPreferSpeed(packReader, itemIndex)))
+	{
+		printf("testUpdatePack: bad copied item data.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	uint8_t byteData[sizeof(bytes)];
+	if (!getPackItemIndex(packReader, "_BIN321_", &itemIndex) || 
+		getPackItemDataSize(packReader, itemIndex) != sizeof(bytes) ||
+		readPackItemData(packReader, itemIndex, byteData, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(byteData, bytes, sizeof(bytes)) != 0 || !getPackItemIndex(packReader, "new/_BIN654_", &itemIndex) ||
+		getPackItemZipSize(packReader, itemIndex) != 0)
+	{
+		printf("testUpdatePack: bad updated item data.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	destroyPackReader(packReader);
+	return true;
+}
+
+inline static bool testCorruptedPack(bool isMapped)
+{
+	const char* files[4] =
+	{
+		"lorem-ipsum.txt", "lorem-ipsum",
+		"_BIN654", "new/_BIN654_"
+	};
+	const uint8_t bytes[8] = 
+	{
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+
+	if (!createTestFile(files[0], LOREM_IPSUM, strlen(LOREM_IPSUM)) ||
+		!createTestFile(files[2], bytes, sizeof(bytes)))
+	{
+		remove(files[0]); remove(files[2]);
+		return false;
+	}
+
+	// NOTE: Second item is stored without compression, so a flipped byte is found only by the checksum.
+	PackResult packResult = packFiles(TEST_FILE_NAME, 2, 
+		files, 0, 0.1f, false, false, true, 1, false, 0, 0, NULL, NULL, onTestItemZip, NULL);
+	remove(files[0]); remove(files[2]);
+
+	PackReader packReader; uint64_t itemIndex, loremIndex;
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = createFilePackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testCorruptedPack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+	if (!getPackItemIndex(packReader, "new/_BIN654_", &itemIndex) || getPackItemZipSize(packReader, itemIndex) != 0)
+	{
+		printf("testCorruptedPack: bad stored item.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	uint64_t fileOffset = getPackItemFileOffset(packReader, itemIndex) + 3;
+	destroyPackReader(packReader);
+
+	FILE* packFile = openFile(TEST_FILE_NAME, "r+b");
+	if (!packFile)
+		return false;
+
+	uint8_t value;
+	bool isCorrupted = seekFile(packFile, (int64_t)fileOffset, SEEK_SET) == 0 && 
+		fread(&value, sizeof(uint8_t), 1, packFile) == 1;
+	value ^= 0x01;
+	isCorrupted &= seekFile(packFile, (int64_t)fileOffset, SEEK_SET) == 0 && 
+		fwrite(&value, sizeof(uint8_t), 1, packFile) == 1;
+	closeFile(packFile);
+
+	if (!isCorrupted)
+	{
+		printf("testCorruptedPack: failed to corrupt pack.");
+		return false;
+	}
+
+	if (isMapped)
+		packResult = createMappedPackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+	else packResult = createFilePackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testCorruptedPack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	uint8_t byteData[sizeof(bytes)]; char loremIpsum[sizeof(LOREM_IPSUM)];
+	if (readPackItemData(packReader, itemIndex, byteData, 0) != SUCCESS_PACK_RESULT || 
+		memcmp(byteData, bytes, sizeof(bytes)) == 0)
+	{
+		printf("testCorruptedPack: corrupted item is not read without verification.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	setPackReaderVerify(packReader, true);
+	if (readPackItemData(packReader, itemIndex, byteData, 0) != BAD_ITEM_CHECKSUM_PACK_RESULT ||
+		!getPackItemIndex(packReader, "lorem-ipsum", &loremIndex) ||
+		readPackItemData(packReader, loremIndex, (uint8_t*)loremIpsum, 0) != SUCCESS_PACK_RESULT)
+	{
+		printf("testCorruptedPack: corrupted item is not detected.");
+		destroyPackReader(packReader);
+		return false;
+	}
+	destroyPackReader(packReader);
+
+	packResult = verifyPackFiles(TEST_FILE_NAME, 2, false);
+	if (packResult != BAD_ITEM_CHECKSUM_PACK_RESULT)
+	{
+		printf("testCorruptedPack: incorrect verify result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+	return true;
+}
+
+inline static bool testSolidPack(bool preferSpeed, bool isMapped)
+{
+	const char* files[6] =
+	{
+		"lorem-ipsum.txt", "text/lorem-ipsum",
+		"lorem-ipsum-half.txt", "text/lorem-ipsum-half",
+		"_BIN123", "_BIN123"
+	};
+	const uint8_t bytes[8] = 
+	{
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+
+	size_t halfSize = strlen(LOREM_IPSUM) / 2;
+	if (!createTestFile(files[0], LOREM_IPSUM, strlen(LOREM_IPSUM)) ||
+		!createTestFile(files[2], LOREM_IPSUM, halfSize) || !createTestFile(files[4], bytes, sizeof(bytes)))
+	{
+		remove(files[0]); remove(files[2]); remove(files[4]);
+		return false;
+	}
+
+	PackResult packResult = packFiles(TEST_FILE_NAME, 3, files, 
+		0, 0.1f, preferSpeed, false, false, 2, false, 4096, 0, NULL, NULL, NULL, NULL);
+	remove(files[0]); remove(files[2]); remove(files[4]);
+
+	PackReader packReader;
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		if (isMapped)
+			packResult = createMappedPackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+		else packResult = createFilePackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+	}
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testSolidPack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	// NOTE: Second item is read from the cached block, range read uses offset inside the item.
+	uint64_t itemIndex, halfIndex; char loremIpsum[sizeof(LOREM_IPSUM)];
+	if (!getPackItemIndex(packReader, "text/lorem-ipsum", &itemIndex) || 
+		!getPackItemIndex(packReader, "text/lorem-ipsum-half", &halfIndex) ||
+		!isPackItemSolid(packReader, itemIndex) || !isPackItemSolid(packReader, halfIndex) ||
+		getPackItemFileOffset(packReader, itemIndex) != getPackItemFileOffset(packReader, halfIndex) ||
+		readPackItemData(packReader, itemIndex, (uint8_t*)loremIpsum, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(loremIpsum, LOREM_IPSUM, strlen(LOREM_IPSUM)) != 0 ||
+		readPackItemData(packReader, halfIndex, (uint8_t*)loremIpsum, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(loremIpsum, LOREM_IPSUM, halfSize) != 0 ||
+		readPackItemRange(packReader, halfIndex, 6, 5, (uint8_t*)loremIpsum) != SUCCESS_PACK_RESULT ||
+		memcmp(loremIpsum, "ipsum", 5) != 0 || getPackItemDataPointer(packReader, itemIndex) != NULL)
+	{
+		printf("testSolidPack: bad solid item data.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	uint8_t byteData[sizeof(bytes)];
+	if (!getPackItemIndex(packReader, "_BIN123", &itemIndex) || isPackItemSolid(packReader, itemIndex) ||
+		readPackItemDataConcurrent(packReader, itemIndex, byteData) != SUCCESS_PACK_RESULT ||
+		memcmp(byteData, bytes, sizeof(bytes)) != 0)
+	{
+		printf("testSolidPack: bad raw item data.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	destroyPackReader(packReader);
+	return true;
+}
+
+inline static bool testPackWriter(bool preferSpeed)
+{
+	const uint8_t bytes[8] = 
+	{
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+
+	if (!createTestFile("_BIN123", bytes, sizeof(bytes)))
+		return false;
+
+	PackWriter packWriter;
+	PackResult packResult = createPackWriter(TEST_FILE_NAME, 0, 0.1f, preferSpeed, false, false, 2, 0, &packWriter);
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = addPackItemData(packWriter, "text/lorem-ipsum", LOREM_IPSUM, (uint32_t)strlen(LOREM_IPSUM));
+	if (packResult == SUCCESS_PACK_RESULT && addPackItemData(packWriter, 
+		"empty", LOREM_IPSUM, 0) != BAD_DATA_SIZE_PACK_RESULT)
+	{
+		packResult = FAILED_TO_GET_ITEM_PACK_RESULT;
+	}
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = addPackItemFile(packWriter, "_BIN123", "bin/_BIN123");
+	if (packResult == SUCCESS_PACK_RESULT && (addPackItemData(packWriter, "text/lorem-ipsum", 
+		bytes, sizeof(bytes)) != DUPLICATE_ITEM_PATH_PACK_RESULT || addPackItemFile(packWriter, 
+		"_BIN123", "bin/_BIN123") != DUPLICATE_ITEM_PATH_PACK_RESULT))
+	{
+		packResult = FAILED_TO_GET_ITEM_PACK_RESULT;
+	}
+	if (packResult == SUCCESS_PACK_RESULT && getPackWriterItemCount(packWriter) != 2)
+		packResult = BAD_DATA_SIZE_PACK_RESULT;
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = finishPackWriter(packWriter, false, 0, NULL, NULL, NULL, NULL);
+	destroyPackWriter(packWriter);
+	remove("_BIN123");
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPackWriter: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	PackReader packReader;
+	packResult = createFilePackReader(TEST_FILE_NAME, 0, false, 1, &packReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPackWriter: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	uint64_t itemIndex; char loremIpsum[sizeof(LOREM_IPSUM)]; uint8_t byteData[sizeof(bytes)]; uint32_t checksum;
+	setPackReaderVerify(packReader, true);
+
+	if (getPackItemCount(packReader) != 2 || !getPackItemIndex(packReader, "text/lorem-ipsum", &itemIndex) ||
+		getPackItemChecksum(packReader, itemIndex, &checksum) ||
+		getPackItemDataSize(packReader, itemIndex) != strlen(LOREM_IPSUM) ||
+		readPackItemData(packReader, itemIndex, (uint8_t*)loremIpsum, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(loremIpsum, LOREM_IPSUM, strlen(LOREM_IPSUM)) != 0 ||
+		getPackItemIndex(packReader, "empty", &itemIndex) ||
+		!getPackItemIndex(packReader, "bin/_BIN123", &itemIndex) ||
+		readPackItemData(packReader, itemIndex, byteData, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(byteData, bytes, sizeof(bytes)) != 0)
+	{
+		printf("testPackWriter: bad item data.");
+		destroyPackReader(packReader);
+		return false;
+	}
+
+	destroyPackReader(packReader);
+	return true;
+}
+
+inline static bool testMemoryPack()
+{
+	const char* files[4] =
+	{
+		"lorem-ipsum.txt", "lorem-ipsum",
+		"_BIN123", "_BIN123"
+	};
+	const uint8_t bytes[8] = 
+	{
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+
+	if (!createTestFile(files[0], LOREM_IPSUM, strlen(LOREM_IPSUM)) ||
+		!createTestFile(files[2], bytes, sizeof(bytes)))
+	{
+		remove(files[0]); remove(files[2]);
+		return false;
+	}
+
+	PackResult packResult = packFiles(TEST_FILE_NAME, 2, files, 
+		0, 0.1f, false, false, true, 1, false, 0, 0, NULL, NULL, NULL, NULL);
+	remove(files[0]); remove(files[2]);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testMemoryPack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		return false;
+	}
+
+	FILE* packFile = openFile(TEST_FILE_NAME, "rb");
+	if (!packFile)
+		return false;
+
+	seekFile(packFile, 0, SEEK_END);
+	size_t packSize = (size_t)tellFile(packFile);
+	seekFile(packFile, 0, SEEK_SET);
+
+	uint8_t* packData = malloc(packSize);
+	if (!packData || fread(packData, sizeof(uint8_t), packSize, packFile) != packSize)
+	{
+		closeFile(packFile); free(packData);
+		return false;
+	}
+	closeFile(packFile);
+
+	PackReader packReader;
+	packResult = createMemoryPackReader(packData, sizeof(PackHeader) - 1, 0, 1, &packReader);
+	if (packResult != BAD_DATA_SIZE_PACK_RESULT)
+	{
+		printf("testMemoryPack: incorrect truncated result. "
+			"(%s)\n", packResultToString(packResult));
+		free(packData);
+		return false;
+	}
+
+	packResult = createMemoryPackReader(packData, packSize, 0, 1, &packReader);
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testMemoryPack: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		free(packData);
+		return false;
+	}
+
+	uint64_t itemIndex; char loremIpsum[sizeof(LOREM_IPSUM)];
+	setPackReaderVerify(packReader, true);
+
+	if (!isPackReaderMapped(packReader) || !getPackItemIndex(packReader, "lorem-ipsum", &itemIndex) ||
+		readPackItemData(packReader, itemIndex, (uint8_t*)loremIpsum, 0) != SUCCESS_PACK_RESULT ||
+		memcmp(loremIpsum, LOREM_IPSUM, strlen(LOREM_IPSUM)) != 0)
+	{
+		printf("testMemoryPack: bad item data.");
+		destroyPackReader(packReader); free(packData);
+		return false;
+	}
+
+	const uint8_t* bytePointer = NULL;
+	if (getPackItemIndex(packReader, "_BIN123", &itemIndex))
+		bytePointer = getPackItemDataPointer(packReader, itemIndex);
+
+	if (bytePointer != packData + getPackItemFileOffset(packReader, itemIndex) || 
+		memcmp(bytePointer, bytes, sizeof(bytes)) != 0)
+	{
+		printf("testMemoryPack: bad item data pointer.");
+		destroyPackReader(packReader); free(packData);
+		return false;
+	}
+
+	destroyPackReader(packReader);
+	free(packData);
+	return true;
+}
+
+inline static bool testPackOverlay()
+{
+	const char* baseFiles[4] =
+	{
+		"lorem-ipsum.txt", "lorem-ipsum",
+		"_BIN123", "_BIN123"
+	};
+	const char* patchFiles[4] =
+	{
+		"_BIN456", "_BIN123",
+		"lorem-ipsum.txt", "dlc/lorem-ipsum"
+	};
+	const uint8_t bytes[8] = 
+	{
+		0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+	};
+
+	if (!createTestFile(baseFiles[0], LOREM_IPSUM, strlen(LOREM_IPSUM)) ||
+		!createTestFile(baseFiles[2], bytes, 4) || !createTestFile(patchFiles[0], bytes, sizeof(bytes)))
+	{
+		remove(baseFiles[0]); remove(baseFiles[2]); remove(patchFiles[0]);
+		return false;
+	}
+
+	PackResult packResult = packFiles(TEST_FILE_NAME, 2, baseFiles, 
+		0, 0.1f, false, false, false, 1, false, 0, 0, NULL, NULL, NULL, NULL);
+	if (packResult == SUCCESS_PACK_RESULT)
+	{
+		packResult = packFiles(TEST_PATCH_FILE_NAME, 2, patchFiles, 
+			0, 0.1f, false, false, false, 1, false, 0, 0, NULL, NULL, NULL, NULL);
+	}
+	remove(baseFiles[0]); remove(baseFiles[2]); remove(patchFiles[0]);
+
+	PackReader packReaders[2] = { NULL, NULL };
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = createFilePackReader(TEST_FILE_NAME, 0, false, 1, &packReaders[0]);
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = createFilePackReader(TEST_PATCH_FILE_NAME, 0, false, 1, &packReaders[1]);
+
+	PackOverlay packOverlay = NULL;
+	if (packResult == SUCCESS_PACK_RESULT)
+		packResult = createPackOverlay(packReaders, 2, &packOverlay);
+
+	if (packResult != SUCCESS_PACK_RESULT)
+	{
+		printf("testPackOverlay: incorrect result. "
+			"(%s)\n", packResultToString(packResult));
+		destroyPackReader(packReaders[1]); destroyPackReader(packReaders[0]);
+		return false;
+	}
+
+	PackOverlayItem loremItem, binItem, dlcItem, missingItem;
+	uint8_t byteData[sizeof(bytes)];
+	bool isValid = getPackOverlayItemCount(packOverlay) == 3 && getPackOverlayPackCount(packOverlay) == 2 &&
+		getPackOverlayItem(packOverlay, "lorem-ipsum", &loremItem) && loremItem.packIndex == 0 &&
+		loremItem.packReader == packReaders[0] && getPackOverlayItem(packOverlay, "_BIN123", &binItem) && 
+		binItem.packIndex == 1 && binItem.packReader == packReaders[1] &&
+		getPackOverlayItem(packOverlay, "dlc/lorem-ipsum", &dlcItem) && dlcItem.packIndex == 1 &&
+		!getPackOverlayItem(packOverlay, "missing", &missingItem) &&
+		getPackItemDataSize(binItem.packReader, binItem.itemIndex) == sizeof(bytes) &&
+		readPackItemData(binItem.packReader, binItem.itemIndex, byteData, 0) == SUCCESS_PACK_RESULT &&
+		memcmp(byteData, bytes, sizeof(bytes)) == 0;
+
+	destroyPackOverlay(packOverlay);
+	destroyPackReader(packReaders[1]); destroyPackReader(packReaders[0]);
+	remove(TEST_PATCH_FILE_NAME);
+
+	if (!isValid)
+	{
+		printf("testPackOverlay: bad resolved item.");
+		return false;
+	}
 	return true;
 }
 
 int main()
 {
 	bool result = testFailedToOpenFile();
-	result &= testPacker(false);
-	result &= testPacker(true);
+	result &= testPacker(false, false, false);
+	result &= testPacker(true, false, false);
+	result &= testPacker(false, false, true);
+	result &= testPacker(true, false, true);
+	result &= testPacker(false, true, false);
+	result &= testPacker(true, true, true);
+	result &= testPackBatch(false);
+	result &= testPackBatch(true);
+	result &= testUnpack(false);
+	result &= testUnpack(true);
+	result &= testUpdatePack(false);
+	result &= testUpdatePack(true);
+	result &= testCorruptedPack(false);
+	result &= testCorruptedPack(true);
+	result &= testSolidPack(false, false);
+	result &= testSolidPack(true, true);
+	result &= testPackWriter(false);
+	result &= testPackWriter(true);
+	result &= testMemoryPack();
+	result &= testPackOverlay();
 	remove(TEST_FILE_NAME);
 	return result ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
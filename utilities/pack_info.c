@@ -45,11 +45,15 @@ int main(int argc, char *argv[])
 		"    Data version: %u\n"
 		"    Big endian: %s\n"
 		"    Prefer speed: %s\n"
-		"    Item count: %llu\n\n",
+		"    Item count: %llu\n"
+		"    Index size: %llu bytes\n"
+		"    Dictionary size: %u bytes\n"
+		"    Has checksums: %s\n\n",
 		PACK_VERSION_MAJOR, PACK_VERSION_MINOR, PACK_VERSION_PATCH,
 		header.versionMajor, header.versionMinor, header.versionPatch, header.dataVersion, 
 		header.isBigEndian ? "true" : "false", header.preferSpeed ? "true" : "false", 
-		(long long unsigned int)header.itemCount);
+		(long long unsigned int)header.itemCount, (long long unsigned int)header.indexSize, 
+		(uint32_t)header.dictionarySize, header.hasChecksums ? "true" : "false");
 
 	PackReader packReader;
 	result = createFilePackReader(argv[1], header.dataVersion, false, 1, &packReader);
@@ -68,15 +72,23 @@ int main(int argc, char *argv[])
 		uint32_t zipSize = getPackItemZipSize(packReader, i);
 		totalDataSize += dataSize; totalZipSize += zipSize;
 
+		uint32_t checksum = 0;
+		getPackItemChecksum(packReader, i, &checksum);
+
 		printf("Item %llu:\n"
 			"    Path: %s\n"
 			"    Data size: %u bytes\n"
 			"    Zip size: %u bytes\n"
 			"    File offset: %llu bytes\n"
-			"    Is reference: %s\n",
-			(long long unsigned int)i, getPackItemPath(packReader, i), dataSize, 
+			"    Is reference: %s\n"
+			"    Prefer speed: %s\n"
+			"    Is solid: %s\n"
+			"    Checksum: %08X\n",
+			(long long unsigned int)i, getPackItemPath(packReader, i), dataSize,
 			zipSize, (long long unsigned int)getPackItemFileOffset(packReader, i),
-			isPackItemReference(packReader, i) ? "true" : "false");
+			isPackItemReference(packReader, i) ? "true" : "false",
+			isPackItemPreferSpeed(packReader, i) ? "true" : "false",
+			isPackItemSolid(packReader, i) ? "true" : "false", checksum);
 		fflush(stdout);
 	}
 
@@ -0,0 +1,72 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pack/reader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void printVerifierHelp()
+{
+	printf("Usage: pack-verify [-j] <pack-path>\n"
+		"\n"
+		"Options:\n"
+		"  -j <threadCount>  Specifies item verification thread count. Default value is 1.\n"
+	);
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t threadCount = 1;
+	int argOffset = 1;
+
+	while (argOffset + 1 < argc)
+	{
+		const char* arg = argv[argOffset];
+		if (strcmp(arg, "-j") == 0)
+		{
+			int threads = atoi(argv[argOffset + 1]);
+			if (threads <= 0)
+			{
+				printf("Bad thread count value, should be greater than 0.\n");
+				return EXIT_FAILURE;
+			}
+
+			threadCount = (uint32_t)threads;
+			argOffset += 2;
+			continue;
+		}
+		else
+		{
+			printVerifierHelp();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (argOffset + 1 != argc)
+	{
+		printVerifierHelp();
+		return EXIT_FAILURE;
+	}
+
+	PackResult result = verifyPackFiles(argv[argOffset], threadCount, true);
+	if (result != SUCCESS_PACK_RESULT)
+	{
+		printf("\nError: %s.\n", packResultToString(result));
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
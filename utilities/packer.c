@@ -18,10 +18,131 @@
 #include <stdlib.h>
 #include <string.h>
 
+typedef struct PackerZipPatterns
+{
+	const char** fastPatterns;
+	const char** nonePatterns;
+	int fastPatternCount;
+	int nonePatternCount;
+} PackerZipPatterns;
+
+static bool matchPackerPattern(const char* pattern, const char* path)
+{
+	// NOTE: Supports '*' (any characters) and '?' (any character) wildcards.
+	const char* starPattern = NULL; const char* starPath = NULL;
+	while (*path)
+	{
+		if (*pattern == '*')
+		{
+			starPattern = ++pattern;
+			starPath = path;
+		}
+		else if (*pattern == '?' || *pattern == *path)
+		{
+			pattern++; path++;
+		}
+		else if (starPattern)
+		{
+			pattern = starPattern;
+			path = ++starPath;
+		}
+		else return false;
+	}
+
+	while (*pattern == '*')
+		pattern++;
+	return *pattern == '\0';
+}
+static PackZipType onPackerItemZip(const char* itemPath, uint32_t dataSize, void* argument)
+{
+	(void)dataSize;
+	const PackerZipPatterns* zipPatterns = (const PackerZipPatterns*)argument;
+	for (int i = 0; i < zipPatterns->nonePatternCount; i++)
+	{
+		if (matchPackerPattern(zipPatterns->nonePatterns[i], itemPath))
+			return NONE_PACK_ZIP_TYPE;
+	}
+	for (int i = 0; i < zipPatterns->fastPatternCount; i++)
+	{
+		if (matchPackerPattern(zipPatterns->fastPatterns[i], itemPath))
+			return LZ4_PACK_ZIP_TYPE;
+	}
+	return DEFAULT_PACK_ZIP_TYPE;
+}
+
+static char* readPackerTrace(const char* tracePath, const char*** traceItemPaths, uint64_t* traceCount)
+{
+	FILE* traceFile = fopen(tracePath, "rb");
+	if (!traceFile)
+		return NULL;
+
+	char* traceData = NULL; size_t traceSize = 0, traceCapacity = 0;
+	while (true)
+	{
+		if (traceSize + 1 >= traceCapacity)
+		{
+			traceCapacity = traceCapacity > 0 ? traceCapacity * 2 : 4096;
+			char* newData = realloc(traceData, traceCapacity);
+			if (!newData)
+			{
+				free(traceData); fclose(traceFile);
+				return NULL;
+			}
+			traceData = newData;
+		}
+
+		size_t readSize = fread(traceData + traceSize, sizeof(char), traceCapacity - traceSize - 1, traceFile);
+		if (readSize == 0)
+			break;
+		traceSize += readSize;
+	}
+
+	bool isError = ferror(traceFile) != 0;
+	fclose(traceFile);
+
+	if (isError)
+	{
+		free(traceData);
+		return NULL;
+	}
+	traceData[traceSize] = '\0';
+
+	uint64_t lineCount = 1;
+	for (size_t i = 0; i < traceSize; i++)
+	{
+		if (traceData[i] == '\n')
+			lineCount++;
+	}
+
+	const char** paths = malloc(lineCount * sizeof(const char*));
+	if (!paths)
+	{
+		free(traceData);
+		return NULL;
+	}
+
+	// NOTE: One item path per line, empty lines are skipped.
+	uint64_t pathCount = 0; char* line = traceData;
+	for (size_t i = 0; i <= traceSize; i++)
+	{
+		if (traceData[i] != '\n' && traceData[i] != '\r' && traceData[i] != '\0')
+			continue;
+
+		traceData[i] = '\0';
+		if (*line != '\0')
+			paths[pathCount++] = line;
+		line = traceData + i + 1;
+	}
+
+	*traceItemPaths = paths;
+	*traceCount = pathCount;
+	return traceData;
+}
+
 static void printPackerHelp()
 {
 	/////////////////////////////////////////////////////////////////////////////////////
-	printf("Usage: packer [-z, -v, -s] <pack-path> <file-path-1> <item-path-1>...\n"
+	printf("Usage: packer [-z, -v, -j, -s, -d, -c, -u, -f, -n, -t, -b] <pack-path> <file-path-1> <item-path-1>...\n"
 		"\n"
 		"Note that file path and item path may differ!\n"
 		"\n"
@@ -32,7 +153,21 @@ static void printPackerHelp()
 		"  -v <dataVersion>  Specifies pack file version. It's used to check if we are \n"
 		"                    loading correct resources pack for a current game or \n"
 		"                    application version. Default value is 0.\n"
+		"  -j <threadCount>  Specifies file compression thread count. Output pack file \n"
+		"                    is the same for any thread count. Default value is 1.\n"
 		"  -s Use faster decompression algorithm sacrificing resources pack file size.\n"
+		"  -d Train and use compression dictionary, improves small files compression.\n"
+		"  -c Stores item data checksums, used to detect damaged items by verification.\n"
+		"  -u <basePackPath> Updates existing pack, copies unchanged items without \n"
+		"                    recompression. Files replace items with the same item path.\n"
+		"  -f <itemPattern>  Compresses matching items with faster decompression algorithm.\n"
+		"                    Pattern supports '*' and '?' wildcards. (ex. \"shaders/*\")\n"
+		"  -n <itemPattern>  Stores matching items without compression. (ex. \"*.png\")\n"
+		"  -t <tracePath>    Lays out items data in the first access order from the trace \n"
+		"                    file, one item path per line. Speeds up the traced loading.\n"
+		"  -b <solidSize>    Compresses items up to this size together in shared blocks, \n"
+		"                    grouped by directory. Useful for thousands of tiny files. \n"
+		"                    Default value is 0, no solid blocks. (0 - 65536 bytes)\n"
 	);
 }
 
@@ -46,8 +181,25 @@ int main(int argc, char *argv[])
 
 	float zipThreshold = 0.1f;
 	uint32_t dataVersion = 0;
+	uint32_t threadCount = 1;
+	uint32_t solidThreshold = 0;
 	int argOffset = 1;
 	bool preferSpeed = false;
+	bool useDictionary = false;
+	bool useChecksums = false;
+	const char* basePackPath = NULL;
+	const char* tracePath = NULL;
+
+	PackerZipPatterns zipPatterns;
+	memset(&zipPatterns, 0, sizeof(PackerZipPatterns));
+	zipPatterns.fastPatterns = malloc(argc * sizeof(const char*));
+	zipPatterns.nonePatterns = malloc(argc * sizeof(const char*));
+
+	if (!zipPatterns.fastPatterns || !zipPatterns.nonePatterns)
+	{
+		printf("Failed to allocate item patterns.\n");
+		return EXIT_FAILURE;
+	}
 	
 	while (true)
 	{
@@ -78,12 +230,74 @@ int main(int argc, char *argv[])
 			argOffset += 2;
 			continue;
 		}
+		else if (strcmp(arg, "-j") == 0)
+		{
+			int threads = atoi(argv[argOffset + 1]);
+			if (threads <= 0)
+			{
+				printf("Bad thread count value, should be greater than 0.\n");
+				return EXIT_FAILURE;
+			}
+
+			threadCount = (uint32_t)threads;
+			argOffset += 2;
+			continue;
+		}
+		else if (strcmp(arg, "-b") == 0)
+		{
+			int solidSize = atoi(argv[argOffset + 1]);
+			if (solidSize < 0 || solidSize > PACK_BLOCK_SIZE)
+			{
+				printf("Bad solid item size value, should be in range 0 - %d bytes.\n", PACK_BLOCK_SIZE);
+				return EXIT_FAILURE;
+			}
+
+			solidThreshold = (uint32_t)solidSize;
+			argOffset += 2;
+			continue;
+		}
 		else if (strcmp(arg, "-s") == 0)
 		{
 			preferSpeed = true;
 			argOffset += 1;
 			continue;
 		}
+		else if (strcmp(arg, "-d") == 0)
+		{
+			useDictionary = true;
+			argOffset += 1;
+			continue;
+		}
+		else if (strcmp(arg, "-c") == 0)
+		{
+			useChecksums = true;
+			argOffset += 1;
+			continue;
+		}
+		else if (strcmp(arg, "-u") == 0)
+		{
+			basePackPath = argv[argOffset + 1];
+			argOffset += 2;
+			continue;
+		}
+		else if (strcmp(arg, "-f") == 0)
+		{
+			zipPatterns.fastPatterns[zipPatterns.fastPatternCount++] = argv[argOffset + 1];
+			argOffset += 2;
+			continue;
+		}
+		else if (strcmp(arg, "-n") == 0)
+		{
+			zipPatterns.nonePatterns[zipPatterns.nonePatternCount++] = argv[argOffset + 1];
+			argOffset += 2;
+			continue;
+		}
+		else if (strcmp(arg, "-t") == 0)
+		{
+			tracePath = argv[argOffset + 1];
+			argOffset += 2;
+			continue;
+		}
 		else if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
 		{
 			printPackerHelp();
@@ -95,14 +309,44 @@ int main(int argc, char *argv[])
 	char* packPath = argv[argOffset++];
 	int itemCount = argc - argOffset;
 
-	if (itemCount <= 0 || itemCount % 2 != 0)
+	if ((itemCount <= 0 && !basePackPath) || itemCount % 2 != 0)
 	{
 		printf("Bad pack file and item count, missing some of the items.\n");
 		return EXIT_FAILURE;
 	}
 
-	PackResult result = packFiles(packPath, itemCount / 2, (const char**)argv + 
-		argOffset, dataVersion, zipThreshold, preferSpeed, true, NULL, NULL);
+	char* traceData = NULL;
+	const char** traceItemPaths = NULL; uint64_t traceCount = 0;
+
+	if (tracePath)
+	{
+		traceData = readPackerTrace(tracePath, &traceItemPaths, &traceCount);
+		if (!traceData)
+		{
+			printf("Failed to read item access trace file.\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	OnPackItemZip onItemZip = NULL;
+	if (zipPatterns.fastPatternCount > 0 || zipPatterns.nonePatternCount > 0)
+		onItemZip = onPackerItemZip;
+
+	PackResult result;
+	if (basePackPath)
+	{
+		result = updatePackFiles(packPath, basePackPath, itemCount / 2, (const char**)argv + argOffset, 
+			dataVersion, zipThreshold, useChecksums, threadCount, true, solidThreshold, 
+			traceCount, traceItemPaths, NULL, onItemZip, &zipPatterns);
+	}
+	else
+	{
+		result = packFiles(packPath, itemCount / 2, (const char**)argv + 
+			argOffset, dataVersion, zipThreshold, preferSpeed, useDictionary, useChecksums, threadCount, 
+			true, solidThreshold, traceCount, traceItemPaths, NULL, onItemZip, &zipPatterns);
+	}
+	free(traceItemPaths); free(traceData);
+	free(zipPatterns.nonePatterns); free(zipPatterns.fastPatterns);
 
 	if (result != SUCCESS_PACK_RESULT)
 	{
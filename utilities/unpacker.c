@@ -16,21 +16,52 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 static void printUnpackerHelp()
 {
-	printf("Usage: unpacker <pack-path>\n");
+	printf("Usage: unpacker [-j] <pack-path>\n"
+		"\n"
+		"Options:\n"
+		"  -j <threadCount>  Specifies file unpacking thread count. Default value is 1.\n"
+	);
 }
 
 int main(int argc, char *argv[])
 {
-	if (argc != 2)
+	uint32_t threadCount = 1;
+	int argOffset = 1;
+
+	while (argOffset + 1 < argc)
+	{
+		const char* arg = argv[argOffset];
+		if (strcmp(arg, "-j") == 0)
+		{
+			int threads = atoi(argv[argOffset + 1]);
+			if (threads <= 0)
+			{
+				printf("Bad thread count value, should be greater than 0.\n");
+				return EXIT_FAILURE;
+			}
+
+			threadCount = (uint32_t)threads;
+			argOffset += 2;
+			continue;
+		}
+		else
+		{
+			printUnpackerHelp();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (argOffset + 1 != argc)
 	{
 		printUnpackerHelp();
 		return EXIT_FAILURE;
 	}
 
-	PackResult result = unpackFiles(argv[1], true);
+	PackResult result = unpackFiles(argv[argOffset], threadCount, true);
 	if (result != SUCCESS_PACK_RESULT)
 	{
 		printf("\nError: %s.\n", packResultToString(result));
@@ -0,0 +1,135 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Layered Pack archive overlay.
+ * @details See the @ref overlay.h
+ */
+
+#pragma once
+#include "pack/reader.hpp"
+
+extern "C"
+{
+#include "pack/overlay.h"
+}
+
+namespace pack
+{
+
+/**
+ * @brief Pack overlay instance handle.
+ * @details See the @ref overlay.h
+ */
+class Overlay final
+{
+private:
+	PackOverlay instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new empty pack overlay.
+	 */
+	Overlay() = default;
+
+	/**
+	 * @brief Creates a new pack overlay instance.
+	 * @details See the @ref createPackOverlay().
+	 * @param[in] readers opened pack readers (from the base to the top)
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	Overlay(const vector<const Reader*>& readers)
+	{
+		vector<PackReader> instances(readers.size());
+		for (size_t i = 0; i < readers.size(); i++)
+		{
+			assert(readers[i]->isOpen());
+			instances[i] = readers[i]->getInstance();
+		}
+
+		auto result = createPackOverlay(instances.data(), (uint32_t)instances.size(), &instance);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	Overlay(const Overlay&) = delete;
+	Overlay(Overlay&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+
+	Overlay& operator=(Overlay&) = delete;
+	Overlay& operator=(Overlay&& r) noexcept
+	{
+		destroyPackOverlay(instance);
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/**
+	 * @brief Destroys pack overlay instance.
+	 * @details See the @ref destroyPackOverlay().
+	 */
+	~Overlay() { destroyPackOverlay(instance); }
+
+	/**
+	 * @brief Returns Pack overlay instance handle.
+	 */
+	PackOverlay getInstance() const noexcept { return instance; }
+
+	/**
+	 * @brief Searches for the topmost pack item by its path. (MT-Safe)
+	 * @details See the @ref getPackOverlayItem().
+	 *
+	 * @param[in] path item path string used to pack the file
+	 * @param[out] item reference to the resolved overlay item handle
+	 *
+	 * @return True if item is found in one of the mounted packs, otherwise false.
+	 */
+	bool getItem(const filesystem::path& path, PackOverlayItem& item) const noexcept
+	{
+		auto _path = path.generic_string();
+		return getPackOverlayItem(instance, _path.c_str(), &item);
+	}
+	/**
+	 * @brief Returns topmost pack item handle. (MT-Safe)
+	 * @details See the @ref getPackOverlayItem().
+	 *
+	 * @param[in] path item path string used to pack the file
+	 * @return The resolved overlay item handle.
+	 * @throw Error if item does not exist.
+	 */
+	PackOverlayItem getItem(const filesystem::path& path) const
+	{
+		PackOverlayItem item;
+		auto _path = path.generic_string();
+		auto result = getPackOverlayItem(instance, _path.c_str(), &item);
+		if (!result)
+			throw Error("Item does not exist");
+		return item;
+	}
+
+	/**
+	 * @brief Returns unique item path count of all mounted packs. (MT-Safe)
+	 */
+	uint64_t getItemCount() const noexcept { return getPackOverlayItemCount(instance); }
+	/**
+	 * @brief Returns mounted pack reader count. (MT-Safe)
+	 */
+	uint32_t getPackCount() const noexcept { return getPackOverlayPackCount(instance); }
+	/**
+	 * @brief Returns mounted pack reader instance. (MT-Safe)
+	 * @param packIndex mounted pack index
+	 */
+	PackReader getReader(uint32_t packIndex) const noexcept { return getPackOverlayReader(instance, packIndex); }
+};
+
+} // namespace pack
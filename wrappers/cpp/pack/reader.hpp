@@ -68,14 +68,35 @@ public:
 	 * @param dataVersion target packed file data version (0 = ignore data version)
 	 * @param isResourcesDirectory read from the resources directory (Android/iOS/macOS only)
 	 * @param threadCount max concurrent read thread count
+	 * @param isMapped map Pack file into the memory (see the @ref createMappedPackReader())
 	 * 
 	 * @throw Error with a @ref PackResult string on failure.
 	 */
 	Reader(const filesystem::path& filePath, uint32_t dataVersion = 0, bool isResourcesDirectory = true,
-		uint32_t threadCount = thread::hardware_concurrency())
+		uint32_t threadCount = thread::hardware_concurrency(), bool isMapped = false)
 	{
 		auto path = filePath.generic_string();
-		auto result = createFilePackReader(path.c_str(), dataVersion, isResourcesDirectory, threadCount, &instance);
+		auto result = isMapped ?
+			createMappedPackReader(path.c_str(), dataVersion, isResourcesDirectory, threadCount, &instance) :
+			createFilePackReader(path.c_str(), dataVersion, isResourcesDirectory, threadCount, &instance);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Creates a new pack reader instance from the memory buffer.
+	 * @details See the @ref createMemoryPackReader().
+	 *
+	 * @param[in] data pack archive data buffer (should stay valid until the reader is destroyed)
+	 * @param size pack archive data size in bytes
+	 * @param dataVersion target packed file data version (0 = ignore data version)
+	 * @param threadCount max concurrent read thread count
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	Reader(const void* data, size_t size, uint32_t dataVersion = 0,
+		uint32_t threadCount = thread::hardware_concurrency())
+	{
+		auto result = createMemoryPackReader(data, size, dataVersion, threadCount, &instance);
 		if (result != SUCCESS_PACK_RESULT)
 			throw Error(packResultToString(result));
 	}
@@ -94,15 +115,41 @@ public:
 	 * @param dataVersion target packed file data version (0 = ignore data version)
 	 * @param isResourcesDirectory read from the resources directory (Android/iOS/macOS only)
 	 * @param threadCount max concurrent read thread count
+	 * @param isMapped map Pack file into the memory (see the @ref createMappedPackReader())
 	 * 
 	 * @throw Error with a @ref PackResult string on failure.
 	 */
 	void open(const filesystem::path& filePath, uint32_t dataVersion = 0, bool isResourcesDirectory = true,
-		uint32_t threadCount = thread::hardware_concurrency())
+		uint32_t threadCount = thread::hardware_concurrency(), bool isMapped = false)
 	{
 		destroyPackReader(instance);
+		instance = nullptr;
+
 		auto path = filePath.generic_string();
-		auto result = createFilePackReader(path.c_str(), dataVersion, isResourcesDirectory, threadCount, &instance);
+		auto result = isMapped ?
+			createMappedPackReader(path.c_str(), dataVersion, isResourcesDirectory, threadCount, &instance) :
+			createFilePackReader(path.c_str(), dataVersion, isResourcesDirectory, threadCount, &instance);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Opens a new Pack reader from the memory buffer.
+	 * @details See the @ref createMemoryPackReader().
+	 *
+	 * @param[in] data pack archive data buffer (should stay valid until the reader is destroyed)
+	 * @param size pack archive data size in bytes
+	 * @param dataVersion target packed file data version (0 = ignore data version)
+	 * @param threadCount max concurrent read thread count
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void open(const void* data, size_t size, uint32_t dataVersion = 0,
+		uint32_t threadCount = thread::hardware_concurrency())
+	{
+		destroyPackReader(instance);
+		instance = nullptr;
+
+		auto result = createMemoryPackReader(data, size, dataVersion, threadCount, &instance);
 		if (result != SUCCESS_PACK_RESULT)
 			throw Error(packResultToString(result));
 	}
@@ -123,6 +170,11 @@ public:
 	 */
 	bool isOpen() const noexcept { return instance; }
 
+	/**
+	 * @brief Returns Pack reader instance handle.
+	 */
+	PackReader getInstance() const noexcept { return instance; }
+
 	/*******************************************************************************************************************
 	 * @brief Returns total Pack item count. (MT-Safe)
 	 * @details See the @ref getPackItemCount().
@@ -250,6 +302,148 @@ public:
 			throw Error(packResultToString(result));
 	}
 
+	/**
+	 * @brief Reads multiple Pack items data. (MT-Safe)
+	 * @details See the @ref readPackItemsBatch().
+	 *
+	 * @param[in] itemIndices uint64_t item index array
+	 * @param[out] buffers target buffer array where to read the items data
+	 * @param itemCount item index and buffer array size
+	 * @param threadIndex current thread index or 0
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void readItemsBatch(const uint64_t* itemIndices, uint8_t** buffers, 
+		uint64_t itemCount, uint32_t threadIndex = 0) const
+	{
+		auto result = readPackItemsBatch(instance, itemIndices, buffers, itemCount, threadIndex);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Reads multiple Pack items data. (MT-Safe)
+	 * @details See the @ref readPackItemsBatch().
+	 *
+	 * @param[in] itemIndices uint64_t item index array
+	 * @param[out] buffers target buffer array where to read the items data
+	 * @param threadIndex current thread index or 0
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void readItemsBatch(const vector<uint64_t>& itemIndices,
+		vector<vector<uint8_t>>& buffers, uint32_t threadIndex = 0) const
+	{
+		buffers.resize(itemIndices.size());
+		vector<uint8_t*> bufferData(itemIndices.size());
+		for (size_t i = 0; i < itemIndices.size(); i++)
+		{
+			buffers[i].resize(getPackItemDataSize(instance, itemIndices[i]));
+			bufferData[i] = buffers[i].data();
+		}
+
+		auto result = readPackItemsBatch(instance, itemIndices.data(), 
+			bufferData.data(), itemIndices.size(), threadIndex);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Hints OS to start loading Pack items data in the background. (MT-Safe)
+	 * @details See the @ref prefetchPackItems().
+	 *
+	 * @param[in] itemIndices uint64_t item index array
+	 * @param itemCount item index array size
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void prefetchItems(const uint64_t* itemIndices, uint64_t itemCount) const
+	{
+		auto result = prefetchPackItems(instance, itemIndices, itemCount);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Hints OS to start loading Pack items data in the background. (MT-Safe)
+	 * @details See the @ref prefetchPackItems().
+	 *
+	 * @param[in] itemIndices uint64_t item index array
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void prefetchItems(const vector<uint64_t>& itemIndices) const
+	{
+		prefetchItems(itemIndices.data(), itemIndices.size());
+	}
+
+	/**
+	 * @brief Returns Pack item binary data pointer inside the mapped archive. (MT-Safe)
+	 * @details See the @ref getPackItemDataPointer().
+	 *
+	 * @param index uint64_t item index
+	 * @return Pointer to the item data, or nullptr if reader is not mapped or item is compressed.
+	 */
+	const uint8_t* getItemDataPointer(uint64_t index) const noexcept
+	{
+		return getPackItemDataPointer(instance, index);
+	}
+
+	/**
+	 * @brief Reads Pack item data from any thread. (MT-Safe)
+	 * @details See the @ref readPackItemDataConcurrent().
+	 *
+	 * @tparam T type of the buffer data
+	 * @param itemIndex uint64_t item index
+	 * @param[out] buffer pointer to the buffer where to read item data
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	template<class T = uint8_t>
+	void readItemDataConcurrent(uint64_t itemIndex, T* buffer) const
+	{
+		auto result = readPackItemDataConcurrent(instance, itemIndex, (uint8_t*)buffer);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Reads part of the Pack item data. (MT-Safe)
+	 * @details See the @ref readPackItemRange().
+	 *
+	 * @param itemIndex uint64_t item index
+	 * @param offset item data offset in bytes
+	 * @param length read data length in bytes
+	 * @param[out] buffer pointer to the buffer where to read item data range
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void readItemRange(uint64_t itemIndex, uint32_t offset, uint32_t length, void* buffer) const
+	{
+		auto result = readPackItemRange(instance, itemIndex, offset, length, (uint8_t*)buffer);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Reads Pack item data from any thread. (MT-Safe)
+	 * @details See the @ref readPackItemDataConcurrent().
+	 *
+	 * @tparam T type of the buffer data
+	 * @param itemIndex uint64_t item index
+	 * @param[out] buffer reference to the buffer where to read item data
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	template<class T = uint8_t>
+	void readItemDataConcurrent(uint64_t itemIndex, vector<T>& buffer) const
+	{
+		assert(getPackItemDataSize(instance, itemIndex) % sizeof(T) == 0);
+		buffer.resize(getPackItemDataSize(instance, itemIndex) / sizeof(T));
+
+		auto result = readPackItemDataConcurrent(instance, itemIndex, (uint8_t*)buffer.data());
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
 	/*******************************************************************************************************************
 	 * @brief Returns Pack item data offset in the archive file. (MT-Safe)
 	 * @details See the @ref getPackItemFileOffset().
@@ -273,6 +467,40 @@ public:
 	{
 		return isPackItemReference(instance, index);
 	}
+	/**
+	 * @brief Returns true if pack item is compressed with fast-read algorithm. (MT-Safe)
+	 * @details See the @ref isPackItemPreferSpeed().
+	 *
+	 * @param index uint64_t item index
+	 * @return True if item is compressed with LZ4, otherwise false.
+	 */
+	bool isItemPreferSpeed(uint64_t index) const noexcept
+	{
+		return isPackItemPreferSpeed(instance, index);
+	}
+	/**
+	 * @brief Returns true if pack item is stored inside the solid block. (MT-Safe)
+	 * @details See the @ref isPackItemSolid().
+	 *
+	 * @param index uint64_t item index
+	 * @return True if item is stored inside the solid block, otherwise false.
+	 */
+	bool isItemSolid(uint64_t index) const noexcept
+	{
+		return isPackItemSolid(instance, index);
+	}
+	/**
+	 * @brief Returns Pack item data checksum. (MT-Safe)
+	 * @details See the @ref getPackItemChecksum().
+	 *
+	 * @param index uint64_t item index
+	 * @param[out] checksum reference to the uint32_t item data checksum
+	 * @return True if pack contains item checksums and writes checksum, otherwise false.
+	 */
+	bool getItemChecksum(uint64_t index, uint32_t& checksum) const noexcept
+	{
+		return getPackItemChecksum(instance, index, &checksum);
+	}
 
 	/**
 	 * @brief Returns Pack item path string. (MT-Safe)
@@ -287,9 +515,13 @@ public:
 	}
 
 	/**
-	 * @brief Returns true if data was compressed with fast-read algorithm. (MT-Safe)
+	 * @brief Returns true if data was compressed with fast-read algorithm by default. (MT-Safe)
 	 */
 	bool isPreferSpeed() const noexcept { return isPackPreferSpeed(instance); }
+	/**
+	 * @brief Returns true if Pack archive is mapped into the memory. (MT-Safe)
+	 */
+	bool isMapped() const noexcept { return isPackReaderMapped(instance); }
 
 	/**
 	 * @brief Returns Pack ZSTD context array. (MT-Safe)
@@ -307,22 +539,251 @@ public:
 	 */
 	void shrink() noexcept { shrinkPack(instance); }
 
+	/**
+	 * @brief Declares Pack reader item access pattern.
+	 * @details See the @ref setPackReaderAccess().
+	 * @param access item access pattern
+	 */
+	void setAccess(PackAccess access) noexcept { setPackReaderAccess(instance, access); }
+	/**
+	 * @brief Returns Pack reader declared item access pattern. (MT-Safe)
+	 */
+	PackAccess getAccess() const noexcept { return getPackReaderAccess(instance); }
+
+	/**
+	 * @brief Enables or disables Pack item data verification on read.
+	 * @details See the @ref setPackReaderVerify().
+	 * @param verifyChecksums verify item data checksums
+	 */
+	void setVerify(bool verifyChecksums) noexcept { setPackReaderVerify(instance, verifyChecksums); }
+	/**
+	 * @brief Returns true if Pack reader verifies item data checksums. (MT-Safe)
+	 */
+	bool isVerify() const noexcept { return isPackReaderVerify(instance); }
+
+	/*******************************************************************************************************************
+	 * @brief Enables Pack decompressed item cache.
+	 * @details See the @ref setPackItemCacheCapacity().
+	 * @param capacity max cached item data size in bytes (0 = disable cache)
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void setItemCacheCapacity(uint64_t capacity)
+	{
+		auto result = setPackItemCacheCapacity(instance, capacity);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Returns Pack decompressed item cache capacity in bytes, or 0 if cache is disabled. (MT-Safe)
+	 */
+	uint64_t getItemCacheCapacity() const noexcept { return getPackItemCacheCapacity(instance); }
+	/**
+	 * @brief Returns Pack decompressed item cache statistics. (MT-Safe)
+	 * @details See the @ref getPackItemCacheStats().
+	 */
+	PackCacheStats getItemCacheStats() const noexcept
+	{
+		PackCacheStats stats;
+		getPackItemCacheStats(instance, &stats);
+		return stats;
+	}
+
+	/**
+	 * @brief Returns Pack reader performance statistics. (MT-Safe)
+	 * @details See the @ref getPackReaderStats().
+	 */
+	PackReaderStats getStats() const noexcept
+	{
+		PackReaderStats stats;
+		getPackReaderStats(instance, &stats);
+		return stats;
+	}
+
 	/*******************************************************************************************************************
 	 * @brief Unpacks files from the pack. (MT-Safe)
 	 * @details See the @ref unpackFiles().
 	 *
 	 * @param[in] filePath target Pack file path string
+	 * @param threadCount item unpacking thread count (including calling thread)
 	 * @param printProgress output unpacking progress to the stdout
 	 * 
 	 * @throw Error with a @ref PackResult string on failure.
 	 */
-	static void unpack(const filesystem::path& filePath, bool printProgress = false)
+	static void unpack(const filesystem::path& filePath, uint32_t threadCount = 1, bool printProgress = false)
 	{
 		auto path = filePath.generic_string();
-		auto result = unpackFiles(path.c_str(), printProgress);
+		auto result = unpackFiles(path.c_str(), threadCount, printProgress);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Verifies all pack item data checksums. (MT-Safe)
+	 * @details See the @ref verifyPackFiles().
+	 *
+	 * @param[in] filePath target Pack file path string
+	 * @param threadCount item verification thread count (including calling thread)
+	 * @param printProgress output verification progress to the stdout
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	static void verify(const filesystem::path& filePath, uint32_t threadCount = 1, bool printProgress = false)
+	{
+		auto path = filePath.generic_string();
+		auto result = verifyPackFiles(path.c_str(), threadCount, printProgress);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+};
+
+/***********************************************************************************************************************
+ * @brief Pack item data stream instance handle.
+ * @details See the @ref openPackItemStream()
+ */
+class ItemStream final
+{
+private:
+	PackItemStream instance = nullptr;
+public:
+	/**
+	 * @brief Opens a new Pack item data stream. (MT-Safe)
+	 * @details See the @ref openPackItemStream().
+	 *
+	 * @param[in] reader opened Pack reader instance
+	 * @param itemIndex uint64_t item index
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	ItemStream(const Reader& reader, uint64_t itemIndex)
+	{
+		assert(reader.isOpen());
+		auto result = openPackItemStream(reader.getInstance(), itemIndex, &instance);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	ItemStream(const ItemStream&) = delete;
+	ItemStream(ItemStream&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+	
+	ItemStream& operator=(ItemStream&) = delete;
+	ItemStream& operator=(ItemStream&& r) noexcept
+	{
+		closePackItemStream(instance);
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/**
+	 * @brief Closes Pack item data stream.
+	 * @details See the @ref closePackItemStream().
+	 */
+	~ItemStream() { closePackItemStream(instance); }
+
+	/**
+	 * @brief Reads next Pack item data chunk from the stream.
+	 * @details See the @ref readPackItemStream().
+	 *
+	 * @param[out] buffer target buffer where to read the item data chunk
+	 * @param bufferSize target buffer size in bytes
+	 * @return Read data size in bytes, or 0 if the end of the item data is reached.
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	uint32_t read(uint8_t* buffer, uint32_t bufferSize)
+	{
+		uint32_t readSize;
+		auto result = readPackItemStream(instance, buffer, bufferSize, &readSize);
 		if (result != SUCCESS_PACK_RESULT)
 			throw Error(packResultToString(result));
+		return readSize;
 	}
+
+	/**
+	 * @brief Returns Pack item stream read data offset in bytes.
+	 */
+	uint32_t getOffset() const noexcept { return getPackItemStreamOffset(instance); }
+};
+
+/***********************************************************************************************************************
+ * @brief Pack read queue instance handle.
+ * @details See the @ref createPackReadQueue()
+ */
+class ReadQueue final
+{
+private:
+	PackReadQueue instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new Pack read queue instance.
+	 * @details See the @ref createPackReadQueue().
+	 *
+	 * @param[in] reader opened Pack reader instance
+	 * @param queueDepth max in flight item read count
+	 * @param[in] onItemRead item read completion function
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	ReadQueue(const Reader& reader, uint32_t queueDepth, OnPackItemRead onItemRead)
+	{
+		assert(reader.isOpen());
+		auto result = createPackReadQueue(reader.getInstance(), queueDepth, onItemRead, &instance);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	ReadQueue(const ReadQueue&) = delete;
+	ReadQueue(ReadQueue&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+	
+	ReadQueue& operator=(ReadQueue&) = delete;
+	ReadQueue& operator=(ReadQueue&& r) noexcept
+	{
+		destroyPackReadQueue(instance);
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/**
+	 * @brief Destroys Pack read queue instance.
+	 * @details See the @ref destroyPackReadQueue().
+	 */
+	~ReadQueue() { destroyPackReadQueue(instance); }
+
+	/**
+	 * @brief Submits a new Pack item read to the queue.
+	 * @details See the @ref submitPackItemRead().
+	 *
+	 * @param itemIndex uint64_t item index
+	 * @param[out] buffer target buffer where to read the item data
+	 * @param[in] argument completion function argument or nullptr
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void submitItemRead(uint64_t itemIndex, uint8_t* buffer, void* argument = nullptr)
+	{
+		auto result = submitPackItemRead(instance, itemIndex, buffer, argument);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Submits queued Pack item reads and handles arrived completions.
+	 * @details See the @ref processPackReadQueue().
+	 * @param waitAll wait until all pending item reads are completed
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void process(bool waitAll = true)
+	{
+		auto result = processPackReadQueue(instance, waitAll);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Returns submitted but not yet completed item read count.
+	 */
+	uint32_t getPendingCount() const noexcept { return getPackReadQueuePendingCount(instance); }
+	/**
+	 * @brief Returns true if read queue uses asynchronous io_uring backend.
+	 */
+	bool isAsync() const noexcept { return isPackReadQueueAsync(instance); }
 };
 
 } // namespace pack
\ No newline at end of file
@@ -20,6 +20,7 @@
 
 #pragma once
 #include "pack/error.hpp"
+#include <utility>
 #include <filesystem>
 
 extern "C"
@@ -31,13 +32,130 @@ namespace pack
 {
 
 /**
- * @brief Pack writer functions.
+ * @brief Pack writer instance handle and functions.
  * @details See the @ref writer.h
  */
 class Writer final
 {
+private:
+	PackWriter instance = nullptr;
 public:
 	/**
+	 * @brief Creates a new empty pack writer.
+	 */
+	Writer() = default;
+
+	/**
+	 * @brief Creates a new incremental pack writer instance.
+	 * @details See the @ref createPackWriter().
+	 *
+	 * @param[in] packPath output Pack file path string
+	 * @param dataVersion packed file data version
+	 * @param zipThreshold compression threshold (0.0 - 1.0 range)
+	 * @param preferSpeed prefer faster decompression algorithm (sacrificing size)
+	 * @param useDictionary train and use compression dictionary for the packed items
+	 * @param useChecksums compute and store item data checksums
+	 * @param threadCount item compression thread count (1 = single threaded)
+	 * @param solidThreshold maximum solid item data size in bytes (0 = no solid blocks)
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	Writer(const filesystem::path& packPath, uint32_t dataVersion = 0, float zipThreshold = 0.1f, 
+		bool preferSpeed = false, bool useDictionary = false, bool useChecksums = false, 
+		uint32_t threadCount = 1, uint32_t solidThreshold = 0)
+	{
+		auto path = packPath.generic_string();
+		auto result = createPackWriter(path.c_str(), dataVersion, zipThreshold, 
+			preferSpeed, useDictionary, useChecksums, threadCount, solidThreshold, &instance);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	Writer(const Writer&) = delete;
+	Writer(Writer&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+
+	Writer& operator=(Writer&) = delete;
+	Writer& operator=(Writer&& r) noexcept
+	{
+		destroyPackWriter(instance);
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/**
+	 * @brief Destroys pack writer instance.
+	 * @details See the @ref destroyPackWriter().
+	 */
+	~Writer() { destroyPackWriter(instance); }
+
+	/**
+	 * @brief Returns Pack writer instance handle.
+	 */
+	PackWriter getInstance() const noexcept { return instance; }
+
+	/**
+	 * @brief Adds a new item with the memory data.
+	 * @details See the @ref addPackItemData().
+	 *
+	 * @param[in] itemPath item path string inside the pack
+	 * @param[in] data item data buffer (copied)
+	 * @param dataSize item data size in bytes
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void addItem(const filesystem::path& itemPath, const void* data, uint32_t dataSize)
+	{
+		auto path = itemPath.generic_string();
+		auto result = addPackItemData(instance, path.c_str(), data, dataSize);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+	/**
+	 * @brief Adds a new item with the file data.
+	 * @details See the @ref addPackItemFile().
+	 *
+	 * @param[in] filePath packing file path string
+	 * @param[in] itemPath item path string inside the pack
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void addFile(const filesystem::path& filePath, const filesystem::path& itemPath)
+	{
+		auto _filePath = filePath.generic_string();
+		auto _itemPath = itemPath.generic_string();
+		auto result = addPackItemFile(instance, _filePath.c_str(), _itemPath.c_str());
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Writes all added items to the Pack archive.
+	 * @details See the @ref finishPackWriter().
+	 *
+	 * @param printProgress output packing progress to the stdout
+	 * @param traceCount item access trace path count (0 = no trace)
+	 * @param[in] traceItemPaths item access trace path string array, or NULL
+	 * @param[in] onPackFile item packing callback, or NULL
+	 * @param[in] onItemZip item compression type callback, or NULL
+	 * @param[in] argument item packing and item compression callback argument, or NULL
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	void finish(bool printProgress = false, uint64_t traceCount = 0, const char** traceItemPaths = nullptr, 
+		OnPackFile onPackFile = nullptr, OnPackItemZip onItemZip = nullptr, void* argument = nullptr)
+	{
+		auto result = finishPackWriter(instance, printProgress, 
+			traceCount, traceItemPaths, onPackFile, onItemZip, argument);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Returns added item count.
+	 */
+	uint64_t getItemCount() const noexcept { return getPackWriterItemCount(instance); }
+
+	/*******************************************************************************************************************
 	 * @brief Packs files to the Pack archive.
 	 * @details See the @ref packFiles().
 	 *
@@ -47,19 +165,66 @@ public:
 	 * @param dataVersion packed file data version
 	 * @param zipThreshold compression threshold (0.0 - 1.0 range)
 	 * @param preferSpeed prefer faster decompression algorithm (sacrificing size)
+	 * @param useDictionary train and use compression dictionary for the packed files
+	 * @param useChecksums compute and store item data checksums
+	 * @param threadCount file compression thread count (1 = single threaded)
 	 * @param printProgress output packing progress to the stdout
+	 * @param solidThreshold maximum solid item data size in bytes (0 = no solid blocks)
+	 * @param traceCount item access trace path count (0 = no trace)
+	 * @param[in] traceItemPaths item access trace path string array, or NULL
 	 * @param[in] onPackFile file packing callback, or NULL
-	 * @param[in] argument file packing callback argument, or NULL
+	 * @param[in] onItemZip item compression type callback, or NULL
+	 * @param[in] argument file packing and item compression callback argument, or NULL
 	 * 
 	 * @throw Error with a @ref PackResult string on failure.
 	 */
 	static void pack(const filesystem::path& packPath, uint64_t fileCount, const char** fileItemPaths, 
-		uint32_t dataVersion = 0, float zipThreshold = 0.1f, bool preferSpeed = false, 
-		bool printProgress = false, OnPackFile onPackFile = nullptr, void* argument = nullptr)
+		uint32_t dataVersion = 0, float zipThreshold = 0.1f, bool preferSpeed = false, bool useDictionary = false, 
+		bool useChecksums = false, uint32_t threadCount = 1, bool printProgress = false, uint32_t solidThreshold = 0, 
+		uint64_t traceCount = 0, const char** traceItemPaths = nullptr, OnPackFile onPackFile = nullptr, 
+		OnPackItemZip onItemZip = nullptr, void* argument = nullptr)
+	{
+		auto path = packPath.generic_string();
+		auto result = packFiles(path.c_str(), fileCount, fileItemPaths, dataVersion, zipThreshold, preferSpeed, 
+			useDictionary, useChecksums, threadCount, printProgress, solidThreshold, traceCount, traceItemPaths, 
+			onPackFile, onItemZip, argument);
+		if (result != SUCCESS_PACK_RESULT)
+			throw Error(packResultToString(result));
+	}
+
+	/**
+	 * @brief Updates files in the existing Pack archive.
+	 * @details See the @ref updatePackFiles().
+	 *
+	 * @param[in] packPath output Pack file path string (can be the same as basePackPath)
+	 * @param[in] basePackPath existing Pack file path string
+	 * @param fileCount changed file count
+	 * @param[in] fileItemPaths changed file and item path string array (file/item, file/item...)
+	 * @param dataVersion packed file data version
+	 * @param zipThreshold compression threshold (0.0 - 1.0 range)
+	 * @param useChecksums compute and store item data checksums
+	 * @param threadCount file compression thread count (1 = single threaded)
+	 * @param printProgress output packing progress to the stdout
+	 * @param solidThreshold maximum solid item data size in bytes (0 = no solid blocks)
+	 * @param traceCount item access trace path count (0 = no trace)
+	 * @param[in] traceItemPaths item access trace path string array, or NULL
+	 * @param[in] onPackFile file packing callback, or NULL
+	 * @param[in] onItemZip item compression type callback, or NULL
+	 * @param[in] argument file packing and item compression callback argument, or NULL
+	 * 
+	 * @throw Error with a @ref PackResult string on failure.
+	 */
+	static void update(const filesystem::path& packPath, const filesystem::path& basePackPath, 
+		uint64_t fileCount, const char** fileItemPaths, uint32_t dataVersion = 0, float zipThreshold = 0.1f, 
+		bool useChecksums = false, uint32_t threadCount = 1, bool printProgress = false, uint32_t solidThreshold = 0, 
+		uint64_t traceCount = 0, const char** traceItemPaths = nullptr, OnPackFile onPackFile = nullptr, 
+		OnPackItemZip onItemZip = nullptr, void* argument = nullptr)
 	{
 		auto path = packPath.generic_string();
-		auto result = packFiles(path.c_str(), fileCount, fileItemPaths, dataVersion, 
-			zipThreshold, preferSpeed, printProgress, onPackFile, argument);
+		auto basePath = basePackPath.generic_string();
+		auto result = updatePackFiles(path.c_str(), basePath.c_str(), fileCount, fileItemPaths, dataVersion, 
+			zipThreshold, useChecksums, threadCount, printProgress, solidThreshold, traceCount, traceItemPaths, 
+			onPackFile, onItemZip, argument);
 		if (result != SUCCESS_PACK_RESULT)
 			throw Error(packResultToString(result));
 	}